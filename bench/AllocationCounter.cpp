@@ -0,0 +1,50 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocations{0};
+
+void* allocate(size_t size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+}  // namespace
+
+namespace jerry::bench {
+size_t allocationCount() noexcept {
+  return allocations.load(std::memory_order_relaxed);
+}
+}  // namespace jerry::bench
+
+// Every non-aligned form is replaced, including the sized and nothrow ones,
+// so memory from malloc is never handed to a library operator delete (which
+// sanitizers report as a mismatch). Aligned forms keep the library versions
+// for both allocation and release.
+void* operator new(size_t size) {
+  if (void* p = allocate(size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+
+namespace jerry::bench {
+/**
+ * @brief Heap allocations made through operator new since the process
+ * started.
+ *
+ * jerry_bench replaces the global operator new and delete (see
+ * AllocationCounter.cpp) so that benchmarks can report allocations per
+ * document. malloc calls made directly are not counted.
+ */
+size_t allocationCount() noexcept;
+}  // namespace jerry::bench
@@ -0,0 +1,174 @@
+#include "Corpus.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+
+namespace jerry::bench {
+namespace {
+// A fixed-seed xorshift, so every run generates the same corpus.
+class Random {
+public:
+  uint64_t next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  size_t below(size_t n) { return static_cast<size_t>(next() % n); }
+
+  double uniform(double low, double high) {
+    return low + (high - low) * static_cast<double>(next() >> 11) * 0x1p-53;
+  }
+
+private:
+  uint64_t state = 0x9E3779B97F4A7C15ull;
+};
+
+const char* const kWords[] = {
+    "json",  "parser", "fast",   "stream", "value", "object", "array",
+    "token", "simd",   "buffer", "string", "number", "caf\xc3\xa9",
+    "\xe6\x97\xa5\xe6\x9c\xac", "na\xc3\xafve", "\\\"quoted\\\"",
+    "tab\\there", "line\\nbreak", "\\u00e9t\\u00e9"};
+
+std::string words(Random& random, size_t count) {
+  std::string out;
+  for (size_t i = 0; i < count; i++) {
+    if (i) {
+      out += ' ';
+    }
+    out += kWords[random.below(std::size(kWords))];
+  }
+  return out;
+}
+
+std::string number(double value) {
+  char digits[32];
+  int length = std::snprintf(digits, sizeof(digits), "%.15f", value);
+  return std::string(digits, static_cast<size_t>(length));
+}
+}  // namespace
+
+std::string makeTwitterLike(size_t bytes) {
+  Random random;
+  std::string out = "{\"statuses\":[";
+  for (size_t i = 0; out.size() < bytes; i++) {
+    std::string id = std::to_string(505874924095815681ull + i);
+    std::string userId = std::to_string(random.below(1000000000));
+    out += i ? "," : "";
+    out += "{\"metadata\":{\"result_type\":\"recent\",\"iso_language_code\":"
+           "\"ja\"},\"created_at\":\"Sun Aug 31 00:29:15 +0000 2014\",\"id\":" +
+           id + ",\"id_str\":\"" + id + "\",\"text\":\"" +
+           words(random, 8 + random.below(12)) +
+           "\",\"source\":\"<a href=\\\"http://twitter.com\\\" "
+           "rel=\\\"nofollow\\\">web</a>\",\"truncated\":false,"
+           "\"in_reply_to_status_id\":null,\"in_reply_to_user_id\":null,"
+           "\"user\":{\"id\":" +
+           userId + ",\"id_str\":\"" + userId + "\",\"name\":\"" +
+           words(random, 2) + "\",\"screen_name\":\"user" + userId +
+           "\",\"location\":\"" + words(random, 1) +
+           "\",\"description\":\"" + words(random, 10) +
+           "\",\"url\":null,\"protected\":false,\"followers_count\":" +
+           std::to_string(random.below(100000)) +
+           ",\"friends_count\":" + std::to_string(random.below(5000)) +
+           ",\"verified\":false,\"lang\":\"ja\"},\"geo\":null,"
+           "\"retweet_count\":" +
+           std::to_string(random.below(1000)) +
+           ",\"favorite_count\":" + std::to_string(random.below(1000)) +
+           ",\"entities\":{\"hashtags\":[{\"text\":\"" + words(random, 1) +
+           "\",\"indices\":[" + std::to_string(random.below(100)) + "," +
+           std::to_string(random.below(100) + 100) +
+           "]}],\"symbols\":[],\"urls\":[],\"user_mentions\":[{\"screen_"
+           "name\":\"user" +
+           std::to_string(random.below(1000)) + "\",\"id\":" +
+           std::to_string(random.below(1000000)) +
+           ",\"indices\":[0,12]}]},\"favorited\":false,\"retweeted\":false,"
+           "\"lang\":\"ja\"}";
+  }
+  out += "],\"search_metadata\":{\"completed_in\":0.087,\"max_id\":"
+         "505874924095815681,\"query\":\"%E4%B8%80\",\"count\":100}}";
+  return out;
+}
+
+std::string makeCanadaLike(size_t bytes) {
+  Random random;
+  std::string out = "{\"type\":\"FeatureCollection\",\"features\":[{\"type\":"
+                    "\"Feature\",\"properties\":{\"name\":\"Canada\"},"
+                    "\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[";
+  for (size_t ring = 0; out.size() < bytes; ring++) {
+    out += ring ? ",[" : "[";
+    for (size_t i = 0; i < 256 && out.size() < bytes; i++) {
+      out += i ? ",[" : "[";
+      out += number(random.uniform(-141.0, -52.6)) + "," +
+             number(random.uniform(41.7, 83.1)) + "]";
+    }
+    out += "]";
+  }
+  out += "]}}]}";
+  return out;
+}
+
+std::string makeCitmLike(size_t bytes) {
+  Random random;
+  std::string out = "{\"areaNames\":{";
+  for (size_t i = 0; i < 32; i++) {
+    out += (i ? ",\"" : "\"") + std::to_string(205705993 + i) + "\":\"" +
+           words(random, 2) + "\"";
+  }
+  out += "},\"events\":{";
+  size_t half = bytes / 2;
+  for (size_t i = 0; out.size() < half; i++) {
+    std::string id = std::to_string(138586341 + i);
+    out += (i ? ",\"" : "\"") + id + "\":{\"description\":null,\"id\":" +
+           id + ",\"logo\":null,\"name\":\"" + words(random, 3) +
+           "\",\"subTopicIds\":[337184269,337184283],\"subjectCode\":null,"
+           "\"subtitle\":null,\"topicIds\":[324846099,107888604]}";
+  }
+  out += "},\"performances\":[";
+  for (size_t i = 0; out.size() < bytes; i++) {
+    out += i ? "," : "";
+    out += "{\"eventId\":" + std::to_string(138586341 + random.below(1000)) +
+           ",\"id\":" + std::to_string(339887544 + i) +
+           ",\"logo\":null,\"name\":null,\"prices\":[{\"amount\":" +
+           std::to_string(10000 + random.below(90000)) +
+           ",\"audienceSubCategoryId\":337100890,\"seatCategoryId\":"
+           "338937295},{\"amount\":" +
+           std::to_string(10000 + random.below(90000)) +
+           ",\"audienceSubCategoryId\":337100890,\"seatCategoryId\":"
+           "338937296}],\"seatCategories\":[{\"areas\":[{\"areaId\":"
+           "205705999,\"blockIds\":[]},{\"areaId\":205705998,\"blockIds\":"
+           "[]}],\"seatCategoryId\":338937295}],\"seatMapImage\":null,"
+           "\"start\":" +
+           std::to_string(1372701600000ull + 86400000ull * i) +
+           ",\"venueCode\":\"PLEYEL_PLEYEL\"}";
+  }
+  out += "]}";
+  return out;
+}
+
+std::string makeDeepNesting(size_t depth) {
+  std::string out;
+  for (size_t i = 0; i < depth; i++) {
+    out += i % 2 ? "[" : "{\"level\":";
+  }
+  out += "\"bottom\"";
+  for (size_t i = depth; i-- > 0;) {
+    out += i % 2 ? "]" : "}";
+  }
+  return out;
+}
+
+std::string makeNdjson(size_t bytes, size_t& lines) {
+  Random random;
+  std::string out;
+  for (lines = 0; out.size() < bytes; lines++) {
+    out += "{\"id\":" + std::to_string(lines) + ",\"user\":\"" +
+           words(random, 1) + "\",\"tags\":[\"" + words(random, 1) +
+           "\",\"" + words(random, 1) + "\"],\"score\":" +
+           number(random.uniform(0, 100)) + ",\"active\":" +
+           (random.below(2) ? "true" : "false") + "}\n";
+  }
+  return out;
+}
+}  // namespace jerry::bench
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Generated inputs shaped like the usual JSON benchmark files. Each
+// generator is deterministic and produces roughly `bytes` bytes, so runs are
+// comparable across machines without shipping the files.
+namespace jerry::bench {
+/** Like twitter.json: status objects heavy in strings (some with escapes
+ * and non-ASCII text), nested user and entities objects, and nulls. **/
+std::string makeTwitterLike(size_t bytes);
+
+/** Like canada.json: one GeoJSON polygon made almost entirely of long
+ * floating-point coordinate pairs. **/
+std::string makeCanadaLike(size_t bytes);
+
+/** Like citm_catalog.json: wide objects keyed by numeric ids, many short
+ * repeated keys and small integer arrays. **/
+std::string makeCitmLike(size_t bytes);
+
+/** Alternating objects and arrays nested `depth` levels deep. **/
+std::string makeDeepNesting(size_t depth);
+
+/** JSON Lines: one small record per line. Sets `lines` to the count. **/
+std::string makeNdjson(size_t bytes, size_t& lines);
+}  // namespace jerry::bench
@@ -0,0 +1,266 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "Corpus.h"
+#include "Document.h"
+#include "Json.h"
+#include "Lines.h"
+#include "OnDemand.h"
+#include "PathQuery.h"
+#include "Sax.h"
+#include "Tape.h"
+#include "ThreadPool.h"
+#include "Utf8.h"
+#include "Validate.h"
+
+using namespace jerry;
+using namespace jerry::bench;
+
+// Every parser over the same generated corpora. Each benchmark reports
+// bytes/s (as MB/s), docs/s and allocs/doc, so parsers and shapes can be
+// compared on throughput and allocation pressure alike.
+
+namespace {
+enum class Shape { Twitter, Canada, Citm, Deep };
+
+constexpr size_t kCorpusBytes = 1 << 20;
+constexpr size_t kNestingDepth = 512;
+
+// Generated on first use and shared by every benchmark.
+const std::string& corpus(Shape shape) {
+  static const std::string twitter = makeTwitterLike(kCorpusBytes);
+  static const std::string canada = makeCanadaLike(kCorpusBytes);
+  static const std::string citm = makeCitmLike(kCorpusBytes);
+  static const std::string deep = makeDeepNesting(kNestingDepth);
+  switch (shape) {
+    case Shape::Twitter:
+      return twitter;
+    case Shape::Canada:
+      return canada;
+    case Shape::Citm:
+      return citm;
+    case Shape::Deep:
+      break;
+  }
+  return deep;
+}
+
+// Counts events without building anything: the cost of tokenizing alone.
+struct CountingHandler {
+  size_t events = 0;
+
+  bool count() {
+    events++;
+    return true;
+  }
+
+  bool onObjectStart() { return count(); }
+  bool onObjectEnd() { return count(); }
+  bool onArrayStart() { return count(); }
+  bool onArrayEnd() { return count(); }
+  bool onKey(std::string_view) { return count(); }
+  bool onString(std::string_view) { return count(); }
+  bool onNumber(int64_t) { return count(); }
+  bool onNumber(double) { return count(); }
+  bool onBool(bool) { return count(); }
+  bool onNull() { return count(); }
+};
+
+// Runs parse once per iteration over input, which holds `docs` documents.
+template <typename Parse>
+void run(benchmark::State& state, const std::string& input, size_t docs,
+         Parse parse) {
+  size_t before = allocationCount();
+  for (auto _ : state) {
+    if (!parse(input)) {
+      state.SkipWithError("parse failed");
+      return;
+    }
+  }
+  size_t allocations = allocationCount() - before;
+  auto iterations = static_cast<double>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+  state.counters["docs/s"] = benchmark::Counter(
+      iterations * static_cast<double>(docs), benchmark::Counter::kIsRate);
+  state.counters["allocs/doc"] = static_cast<double>(allocations) /
+                                 (iterations * static_cast<double>(docs));
+}
+}  // namespace
+
+static void BM_CorpusJson(benchmark::State& state, Shape shape) {
+  run(state, corpus(shape), 1, [](const std::string& input) {
+    auto json = Json::fromString(input);
+    benchmark::DoNotOptimize(json);
+    return json.has_value();
+  });
+}
+
+static void BM_CorpusFromState(benchmark::State& state, Shape shape) {
+  run(state, corpus(shape), 1, [](const std::string& input) {
+    TokenizerState tokenizerState(input, 0);
+    auto json = Json::fromState(tokenizerState);
+    benchmark::DoNotOptimize(json);
+    return json.has_value();
+  });
+}
+
+// Every iteration parses into the same preallocated buffer, the per-request
+// arena pattern; allocs/doc stays at zero as long as the tree fits.
+static void BM_CorpusPmr(benchmark::State& state, Shape shape) {
+  std::vector<std::byte> buffer(16 * corpus(shape).size());
+  run(state, corpus(shape), 1, [&buffer](const std::string& input) {
+    std::pmr::monotonic_buffer_resource resource(buffer.data(),
+                                                 buffer.size());
+    auto json = Json::fromString(input, &resource);
+    benchmark::DoNotOptimize(json);
+    return json.has_value();
+  });
+}
+
+static void BM_CorpusDocument(benchmark::State& state, Shape shape) {
+  run(state, corpus(shape), 1, [](const std::string& input) {
+    auto doc = Document::fromString(input);
+    benchmark::DoNotOptimize(doc);
+    return doc.has_value();
+  });
+}
+
+static void BM_CorpusTape(benchmark::State& state, Shape shape) {
+  run(state, corpus(shape), 1, [](const std::string& input) {
+    auto tape = Tape::fromString(input);
+    benchmark::DoNotOptimize(tape);
+    return tape.has_value();
+  });
+}
+
+static void BM_CorpusSax(benchmark::State& state, Shape shape) {
+  run(state, corpus(shape), 1, [](const std::string& input) {
+    CountingHandler handler;
+    auto result = parseSax(input, handler);
+    benchmark::DoNotOptimize(handler.events);
+    return static_cast<bool>(result);
+  });
+}
+
+static void BM_CorpusValidate(benchmark::State& state, Shape shape) {
+  run(state, corpus(shape), 1, [](const std::string& input) {
+    auto result = validate(input);
+    benchmark::DoNotOptimize(result);
+    return static_cast<bool>(result);
+  });
+}
+
+#define JERRY_CORPUS_BENCHMARK(name)                                           \
+  BENCHMARK_CAPTURE(name, twitter, Shape::Twitter);                            \
+  BENCHMARK_CAPTURE(name, canada, Shape::Canada);                              \
+  BENCHMARK_CAPTURE(name, citm, Shape::Citm);                                  \
+  BENCHMARK_CAPTURE(name, deep, Shape::Deep)
+
+JERRY_CORPUS_BENCHMARK(BM_CorpusJson);
+JERRY_CORPUS_BENCHMARK(BM_CorpusFromState);
+JERRY_CORPUS_BENCHMARK(BM_CorpusPmr);
+JERRY_CORPUS_BENCHMARK(BM_CorpusDocument);
+JERRY_CORPUS_BENCHMARK(BM_CorpusTape);
+JERRY_CORPUS_BENCHMARK(BM_CorpusSax);
+JERRY_CORPUS_BENCHMARK(BM_CorpusValidate);
+
+// UTF-8 validation alone over the whole twitter corpus, which mixes ASCII
+// with Japanese text, by each implementation.
+static void BM_TwitterUtf8(benchmark::State& state,
+                           utf8::Implementation impl) {
+  run(state, corpus(Shape::Twitter), 1, [impl](const std::string& input) {
+    size_t bad = utf8::findInvalid(input, impl);
+    benchmark::DoNotOptimize(bad);
+    return bad == input.size();
+  });
+}
+BENCHMARK_CAPTURE(BM_TwitterUtf8, scalar, utf8::Implementation::Scalar);
+BENCHMARK_CAPTURE(BM_TwitterUtf8, ssse3, utf8::Implementation::SSSE3);
+BENCHMARK_CAPTURE(BM_TwitterUtf8, avx2, utf8::Implementation::AVX2);
+
+// Three fields of every status in the twitter corpus: once through a
+// compiled PathQuery, once by walking an ondemand::Document by hand.
+static void BM_TwitterPathQuery(benchmark::State& state) {
+  auto query = ondemand::PathQuery::compile(
+      {"/statuses/*/id", "/statuses/*/user/followers_count",
+       "/statuses/*/retweet_count"});
+  run(state, corpus(Shape::Twitter), 1, [&query](const std::string& input) {
+    int64_t sum = 0;
+    bool ok = query->run(input, [&sum](size_t, const ondemand::Value& v) {
+      sum += v.getInt64().value_or(0);
+      return true;
+    });
+    benchmark::DoNotOptimize(sum);
+    return ok;
+  });
+}
+BENCHMARK(BM_TwitterPathQuery);
+
+static void BM_TwitterOnDemand(benchmark::State& state) {
+  run(state, corpus(Shape::Twitter), 1, [](const std::string& input) {
+    auto doc = ondemand::Document::fromString(input);
+    if (!doc) {
+      return false;
+    }
+    int64_t sum = 0;
+    for (ondemand::Value status : (*doc)["statuses"].elements()) {
+      sum += status["id"].getInt64().value_or(0);
+      sum += status["user"]["followers_count"].getInt64().value_or(0);
+      sum += status["retweet_count"].getInt64().value_or(0);
+    }
+    benchmark::DoNotOptimize(sum);
+    return true;
+  });
+}
+BENCHMARK(BM_TwitterOnDemand);
+
+// NDJSON: docs are lines, parsed one at a time and through parseLines with
+// a single worker.
+static const std::string& ndjson(size_t& lines) {
+  static size_t count = 0;
+  static const std::string input = makeNdjson(kCorpusBytes, count);
+  lines = count;
+  return input;
+}
+
+static void BM_NdjsonPerLine(benchmark::State& state) {
+  size_t lines = 0;
+  const std::string& input = ndjson(lines);
+  run(state, input, lines, [](const std::string& input) {
+    std::string_view rest = input;
+    while (!rest.empty()) {
+      size_t end = rest.find('\n');
+      auto json = Json::fromString(rest.substr(0, end));
+      benchmark::DoNotOptimize(json);
+      if (!json) {
+        return false;
+      }
+      rest.remove_prefix(end == std::string_view::npos ? rest.size()
+                                                       : end + 1);
+    }
+    return true;
+  });
+}
+BENCHMARK(BM_NdjsonPerLine);
+
+static void BM_NdjsonParseLines(benchmark::State& state) {
+  size_t lines = 0;
+  const std::string& input = ndjson(lines);
+  ThreadPool pool(1);
+  ParseLinesOptions options;
+  options.pool = &pool;
+  run(state, input, lines, [&options](const std::string& input) {
+    auto result =
+        parseLines(input, [](LineRecord&) { return true; }, options);
+    benchmark::DoNotOptimize(result);
+    return result.errors == 0;
+  });
+}
+BENCHMARK(BM_NdjsonParseLines)->UseRealTime();
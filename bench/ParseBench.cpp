@@ -0,0 +1,371 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "Document.h"
+#include "Json.h"
+#include "KeyPool.h"
+#include "Lines.h"
+#include "OnDemand.h"
+#include "Reflect.h"
+#include "Schema.h"
+#include "Tape.h"
+#include "ThreadPool.h"
+#include "Writer.h"
+
+using namespace jerry;
+
+// Builds a flat array of roughly `bytes` bytes mixing strings and numbers.
+static std::string makeArray(size_t bytes) {
+  std::string out = "[";
+  size_t i = 0;
+  while (out.size() < bytes) {
+    if (i > 0) {
+      out += ", ";
+    }
+    if (i % 2 == 0) {
+      out += "\"item " + std::to_string(i) + "\"";
+    } else {
+      out += std::to_string(i);
+    }
+    i++;
+  }
+  out += "]";
+  return out;
+}
+
+// Parse time should grow linearly with the input size. Benchmark reports the
+// fitted complexity as "BigO" alongside the raw timings.
+static void BM_ParseArrayScaling(benchmark::State& state) {
+  std::string input = makeArray(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto json = Json::fromString(input);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+  state.SetComplexityN(static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_ParseArrayScaling)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Complexity(benchmark::oN);
+
+// Builds an array of small records, roughly `bytes` bytes long.
+static std::string makeRecords(size_t bytes) {
+  std::string out = "[";
+  for (size_t i = 0; out.size() < bytes; i++) {
+    out += (i ? "," : "") + std::string("{\"id\":") + std::to_string(i) +
+           ",\"name\":\"user" + std::to_string(i) +
+           "\",\"score\":" + std::to_string(i % 100) + ".5,\"active\":" +
+           (i % 2 ? "true" : "false") + "}";
+  }
+  out += "]";
+  return out;
+}
+
+// Parse and destroy, the full lifetime of a request-scoped document.
+static void BM_JsonParseAndFree(benchmark::State& state) {
+  std::string input = makeRecords(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto json = Json::fromString(input);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_JsonParseAndFree)->Arg(1 << 16)->Arg(1 << 20);
+
+// The single-pass combinator parser, without the structural index.
+static void BM_JsonFromState(benchmark::State& state) {
+  std::string input = makeRecords(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    TokenizerState tokenizerState(input, 0);
+    auto json = Json::fromState(tokenizerState);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_JsonFromState)->Arg(1 << 16)->Arg(1 << 20);
+
+// BM_JsonParseAndFree with the keys interned in a pool per document, so each
+// record's keys share the first record's buffers.
+static void BM_JsonParseInterned(benchmark::State& state) {
+  std::string input = makeRecords(static_cast<size_t>(state.range(0)));
+  KeyPoolStats keys;
+  for (auto _ : state) {
+    KeyPool pool;
+    auto json = Json::fromString(input, pool);
+    benchmark::DoNotOptimize(json);
+    keys = pool.stats();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+  state.counters["key_bytes_saved"] =
+      static_cast<double>(keys.bytesRequested - keys.bytesStored);
+}
+BENCHMARK(BM_JsonParseInterned)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_DocumentParseAndFree(benchmark::State& state) {
+  std::string input = makeRecords(static_cast<size_t>(state.range(0)));
+  size_t arenaBytes = 0;
+  KeyPoolStats keys;
+  for (auto _ : state) {
+    auto doc = Document::fromString(input);
+    benchmark::DoNotOptimize(doc);
+    arenaBytes = doc->getArena().bytesUsed();
+    keys = doc->getKeyPool().stats();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+  state.counters["arena_bytes_per_input_byte"] =
+      static_cast<double>(arenaBytes) / static_cast<double>(input.size());
+  state.counters["key_bytes_saved"] =
+      static_cast<double>(keys.bytesRequested - keys.bytesStored);
+}
+BENCHMARK(BM_DocumentParseAndFree)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_TapeParse(benchmark::State& state) {
+  std::string input = makeRecords(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto tape = Tape::fromString(input);
+    benchmark::DoNotOptimize(tape);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size()));
+}
+BENCHMARK(BM_TapeParse)->Arg(1 << 16)->Arg(1 << 20);
+
+// One object with `fields` members, a nested "user" near the end, and the
+// handful of fields a typical consumer actually reads.
+static std::string makeWideObject(size_t fields) {
+  std::string out = "{";
+  for (size_t i = 0; i < fields; i++) {
+    out += "\"field" + std::to_string(i) + "\":{\"values\":[" +
+           std::to_string(i) + ",\"text " + std::to_string(i) + "\"]},";
+  }
+  out += "\"user\":{\"id\":42,\"name\":\"jerry\"},\"status\":\"ok\"}";
+  return out;
+}
+
+// Reads three fields out of a wide object: the DOM materializes everything,
+// the on-demand document skips what it does not touch.
+static void BM_WideObjectJson(benchmark::State& state) {
+  std::string input = makeWideObject(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto json = Json::fromString(input);
+    auto value = json->getValue();
+    auto& root = std::get<JsonObject>(value.value);
+    auto& user = std::get<JsonObject>(root["user"].value);
+    benchmark::DoNotOptimize(user["id"]);
+    benchmark::DoNotOptimize(user["name"]);
+    benchmark::DoNotOptimize(root["status"]);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_WideObjectJson)->Arg(100)->Arg(1000);
+
+static void BM_WideObjectOnDemand(benchmark::State& state) {
+  std::string input = makeWideObject(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto doc = ondemand::Document::fromString(input);
+    auto user = (*doc)["user"];
+    benchmark::DoNotOptimize(user["id"].getInt64());
+    benchmark::DoNotOptimize(user["name"].getString());
+    benchmark::DoNotOptimize((*doc)["status"].getString());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_WideObjectOnDemand)->Arg(100)->Arg(1000);
+
+// Member lookup in an already-built object, below and above the size at
+// which JsonObject switches from a linear scan to its hash index.
+static void BM_ObjectLookup(benchmark::State& state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  JsonObject object;
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < size; i++) {
+    keys.push_back("field" + std::to_string(i));
+    object[keys.back()] = JsonValue(static_cast<int64_t>(i));
+  }
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(object.find(keys[next]));
+    next = next + 1 == size ? 0 : next + 1;
+  }
+}
+BENCHMARK(BM_ObjectLookup)->Arg(4)->Arg(16)->Arg(64)->Arg(1024);
+
+namespace {
+struct BenchItem {
+  std::string sku;
+  int64_t quantity = 0;
+};
+JERRY_FIELDS(BenchItem, sku, quantity)
+
+struct BenchOrder {
+  int64_t id = 0;
+  double price = 0;
+  std::optional<std::string> note;
+  std::vector<BenchItem> items;
+};
+JERRY_FIELDS(BenchOrder, id, price, note, items)
+
+struct BenchOrders {
+  std::vector<BenchOrder> orders;
+};
+JERRY_FIELDS(BenchOrders, orders)
+}  // namespace
+
+// {"orders": [...]} of roughly `bytes` bytes. Each order also carries a
+// "meta" object that no struct declares.
+static std::string makeOrders(size_t bytes) {
+  std::string out = "{\"orders\":[";
+  for (size_t i = 0; out.size() < bytes; i++) {
+    out += (i ? "," : "") + std::string("{\"id\":") + std::to_string(i) +
+           ",\"price\":" + std::to_string(i) + ".25,\"note\":" +
+           (i % 3 ? "null" : "\"ring twice\"") +
+           ",\"meta\":{\"source\":\"web\",\"tags\":[1,2,3]}" +
+           ",\"items\":[{\"sku\":\"A-" + std::to_string(i) +
+           "\",\"quantity\":2},{\"sku\":\"B\",\"quantity\":1}]}";
+  }
+  out += "]}";
+  return out;
+}
+
+// Typed structs from the same input: through a JsonValue, then straight in.
+static void BM_OrdersViaJsonValue(benchmark::State& state) {
+  std::string input = makeOrders(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto json = Json::fromString(input);
+    BenchOrders batch;
+    JsonValue value = std::move(*json).getValue();
+    for (const auto& element : std::get<std::vector<JsonValue>>(
+             std::get<JsonObject>(value.value).at("orders").value)) {
+      const auto& fields = std::get<JsonObject>(element.value);
+      BenchOrder& order = batch.orders.emplace_back();
+      order.id = std::get<int64_t>(fields.at("id").value);
+      order.price = std::get<double>(fields.at("price").value);
+      if (auto* note = std::get_if<std::string>(&fields.at("note").value)) {
+        order.note = *note;
+      }
+      for (const auto& item : std::get<std::vector<JsonValue>>(
+               fields.at("items").value)) {
+        const auto& itemFields = std::get<JsonObject>(item.value);
+        order.items.push_back(
+            {std::get<std::string>(itemFields.at("sku").value),
+             std::get<int64_t>(itemFields.at("quantity").value)});
+      }
+    }
+    benchmark::DoNotOptimize(batch);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_OrdersViaJsonValue)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_OrdersParseInto(benchmark::State& state) {
+  std::string input = makeOrders(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto batch = parseInto<BenchOrders>(input);
+    benchmark::DoNotOptimize(batch);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_OrdersParseInto)->Arg(1 << 16)->Arg(1 << 20);
+
+// A fixed-shape market data message, parsed generically and through a
+// schema-specialized tokenizer.
+using Quote = schema::Object<
+    schema::Required<"seq", int64_t>, schema::Required<"symbol", std::string>,
+    schema::Required<"bid", double>, schema::Required<"ask", double>,
+    schema::Required<"bidSize", int64_t>, schema::Required<"askSize", int64_t>,
+    schema::Required<"exchange", std::string>,
+    schema::Optional<"halted", bool>>;
+
+static const std::string kQuote =
+    R"({"seq":918273,"symbol":"ACME","bid":101.25,"ask":101.5,)"
+    R"("bidSize":300,"askSize":1200,"exchange":"XNAS","halted":false})";
+
+static void BM_QuoteFromState(benchmark::State& state) {
+  for (auto _ : state) {
+    TokenizerState tokenizerState(kQuote, 0);
+    auto json = Json::fromState(tokenizerState);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(kQuote.size()));
+}
+BENCHMARK(BM_QuoteFromState);
+
+static void BM_QuoteSchema(benchmark::State& state) {
+  static const auto parser = schema::tokenizer<Quote>();
+  for (auto _ : state) {
+    auto quote = parser.run(TokenizerState(kQuote, 0));
+    benchmark::DoNotOptimize(quote);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(kQuote.size()));
+}
+BENCHMARK(BM_QuoteSchema);
+
+// JSON Lines throughput by worker count. Real time is what matters here:
+// CPU time only measures the thread that collects the results.
+static void BM_ParseLines(benchmark::State& state) {
+  std::string input;
+  for (size_t i = 0; input.size() < (1 << 20); i++) {
+    input += "{\"id\":" + std::to_string(i) + ",\"name\":\"user" +
+             std::to_string(i) + "\",\"tags\":[\"a\",\"b\"],\"score\":" +
+             std::to_string(i % 100) + ".5}\n";
+  }
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  ParseLinesOptions options;
+  options.pool = &pool;
+  for (auto _ : state) {
+    auto result =
+        parseLines(input, [](LineRecord&) { return true; }, options);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_ParseLines)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// One large top-level array split across workers; compare against
+// BM_JsonParseAndFree for the sequential baseline.
+static void BM_ParseArrayParallel(benchmark::State& state) {
+  std::string input = makeRecords(1 << 20);
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto json = Json::fromStringParallel(input, pool);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+BENCHMARK(BM_ParseArrayParallel)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Serializing the documents BM_JsonParseAndFree parses. Bytes are counted
+// on the output, so the MB/s figures of the two are directly comparable.
+static void BM_Write(benchmark::State& state) {
+  std::string input = makeRecords(static_cast<size_t>(state.range(0)));
+  auto json = Json::fromString(input);
+  JsonValue value = std::move(*json).getValue();
+  WriteOptions options{.pretty = state.range(1) != 0};
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    Writer writer(out, options);
+    writer.write(value);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(out.size()));
+}
+BENCHMARK(BM_Write)->ArgsProduct({{1 << 16, 1 << 20}, {0, 1}});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "AllocationCounter.h"
+#include "Tokenizer.h"
+
+using namespace jerry;
+using namespace jerry::bench;
+
+// One benchmark per combinator in Tokenizer.h, each run over an input it
+// accepts. bytes/s is the input the tokenizer consumed, allocs/run the heap
+// allocations per run() call.
+
+template <TokenizerLike P>
+static void runTokenizer(benchmark::State& state, const P& tokenizer,
+                         const std::string& input) {
+  size_t consumed = 0;
+  size_t before = allocationCount();
+  for (auto _ : state) {
+    auto result = tokenizer.run(TokenizerState(input, 0));
+    if (!result) {
+      state.SkipWithError("tokenizer rejected its input");
+      return;
+    }
+    consumed = result->second.getPosition();
+    benchmark::DoNotOptimize(result);
+  }
+  size_t allocations = allocationCount() - before;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(consumed));
+  state.counters["allocs/run"] = static_cast<double>(allocations) /
+                                 static_cast<double>(state.iterations());
+}
+
+static void BM_Character(benchmark::State& state) {
+  runTokenizer(state, character(), "x");
+}
+BENCHMARK(BM_Character);
+
+static void BM_ExpectChar(benchmark::State& state) {
+  runTokenizer(state, expectChar('{'), "{");
+}
+BENCHMARK(BM_ExpectChar);
+
+static void BM_ExpectString(benchmark::State& state) {
+  runTokenizer(state, expectString("false"), "false");
+}
+BENCHMARK(BM_ExpectString);
+
+static void BM_Digit(benchmark::State& state) {
+  runTokenizer(state, digit(), "7");
+}
+BENCHMARK(BM_Digit);
+
+static void BM_Pure(benchmark::State& state) {
+  runTokenizer(state, pure<int>(1), "");
+}
+BENCHMARK(BM_Pure);
+
+static void BM_IsEqual(benchmark::State& state) {
+  runTokenizer(state,
+               character().bind<char>([](char c) { return isEqual(c, 'a'); }),
+               "a");
+}
+BENCHMARK(BM_IsEqual);
+
+static void BM_Map(benchmark::State& state) {
+  runTokenizer(state, character().map<int>([](char c) { return c + 1; }), "a");
+}
+BENCHMARK(BM_Map);
+
+static void BM_Bind(benchmark::State& state) {
+  runTokenizer(state, character().bind<char>([](char) { return character(); }),
+               "ab");
+}
+BENCHMARK(BM_Bind);
+
+// The same bind through the type-erased Tokenizer<T>, for comparison.
+static void BM_BindErased(benchmark::State& state) {
+  Tokenizer<char> erased = character();
+  runTokenizer(state,
+               erased.bind<char>([](char) -> Tokenizer<char> {
+                 return character();
+               }),
+               "ab");
+}
+BENCHMARK(BM_BindErased);
+
+static void BM_OrElse(benchmark::State& state) {
+  // The first alternative fails, so this measures one backtrack.
+  runTokenizer(state, orElse(expectChar('['), expectChar('{')), "{");
+}
+BENCHMARK(BM_OrElse);
+
+static void BM_ManyOf(benchmark::State& state) {
+  runTokenizer(state, manyOf(digit()),
+               std::string(static_cast<size_t>(state.range(0)), '5'));
+}
+BENCHMARK(BM_ManyOf)->Arg(8)->Arg(64);
+
+static void BM_SkipManyWhitespace(benchmark::State& state) {
+  runTokenizer(state, skipMany(whitespace()),
+               std::string(static_cast<size_t>(state.range(0)), ' '));
+}
+BENCHMARK(BM_SkipManyWhitespace)->Arg(1)->Arg(8)->Arg(64);
+
+static void BM_Word(benchmark::State& state) {
+  runTokenizer(state, word(), "tokenizer rest");
+}
+BENCHMARK(BM_Word);
+
+static void BM_Sentence(benchmark::State& state) {
+  runTokenizer(state, sentence(), "the quick brown fox jumps over the dog");
+}
+BENCHMARK(BM_Sentence);
+
+static void BM_Structural(benchmark::State& state) {
+  runTokenizer(state, objectStart(), "{");
+}
+BENCHMARK(BM_Structural);
+
+static void BM_JsonNull(benchmark::State& state) {
+  runTokenizer(state, jsonNull(), "null");
+}
+BENCHMARK(BM_JsonNull);
+
+static void BM_Boolean(benchmark::State& state) {
+  // "false" fails the "true" alternative first.
+  runTokenizer(state, boolean(), state.range(0) ? "true" : "false");
+}
+BENCHMARK(BM_Boolean)->Arg(1)->Arg(0);
+
+static void BM_JsonString(benchmark::State& state) {
+  std::string body(static_cast<size_t>(state.range(0)), 'a');
+  if (state.range(1)) {
+    // An escape every 16 bytes.
+    for (size_t i = 8; i + 1 < body.size(); i += 16) {
+      body[i] = '\\';
+      body[i + 1] = 'n';
+    }
+  }
+  runTokenizer(state, jsonString(), "\"" + body + "\"");
+}
+BENCHMARK(BM_JsonString)->ArgsProduct({{8, 64, 1024}, {0, 1}});
+
+static void BM_JsonNumber(benchmark::State& state) {
+  static const char* const kNumbers[] = {"42", "-1234567890123",
+                                         "3.141592653589793", "-6.02e23"};
+  runTokenizer(state, jsonNumber(), kNumbers[state.range(0)]);
+}
+BENCHMARK(BM_JsonNumber)->DenseRange(0, 3);
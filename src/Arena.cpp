@@ -0,0 +1,29 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace jerry {
+Arena::Arena(size_t firstChunkSize) : nextChunkSize(firstChunkSize) {}
+
+void* Arena::allocate(size_t bytes, size_t alignment) {
+  size_t padding =
+      (alignment - reinterpret_cast<uintptr_t>(cursor) % alignment) % alignment;
+  if (padding + bytes > remaining) {
+    size_t chunkSize = std::max(nextChunkSize, bytes + alignment);
+    chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(chunkSize));
+    cursor = chunks.back().get();
+    remaining = chunkSize;
+    reserved += chunkSize;
+    nextChunkSize = chunkSize * 2;
+    padding =
+        (alignment - reinterpret_cast<uintptr_t>(cursor) % alignment) %
+        alignment;
+  }
+  void* result = cursor + padding;
+  cursor += padding + bytes;
+  remaining -= padding + bytes;
+  used += bytes;
+  return result;
+}
+}  // namespace jerry
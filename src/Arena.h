@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace jerry {
+/**
+ * @brief Bump allocator that releases everything at once.
+ *
+ * Memory comes from a list of chunks that double in size. Nothing is freed
+ * individually; destroying the Arena frees all chunks, so tearing down a
+ * document costs one free per chunk rather than one per node.
+ */
+class Arena {
+public:
+  explicit Arena(size_t firstChunkSize = 4096);
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  void* allocate(size_t bytes, size_t alignment);
+
+  template <typename T> T* allocateArray(size_t count) {
+    return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  /** Bytes handed out by allocate(). **/
+  size_t bytesUsed() const noexcept { return used; }
+  /** Bytes obtained from the system, including unused chunk tails. **/
+  size_t bytesReserved() const noexcept { return reserved; }
+
+private:
+  std::vector<std::unique_ptr<std::byte[]>> chunks;
+  std::byte* cursor = nullptr;
+  size_t remaining = 0;
+  size_t nextChunkSize;
+  size_t used = 0;
+  size_t reserved = 0;
+};
+}  // namespace jerry
@@ -0,0 +1,242 @@
+#include "Document.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Reader.h"
+
+namespace jerry {
+std::optional<bool> ElementRef::getBool() const {
+  if (!isBool()) {
+    return std::nullopt;
+  }
+  return node->boolean;
+}
+
+std::optional<int64_t> ElementRef::getInt64() const {
+  if (!is(NodeType::Integer)) {
+    return std::nullopt;
+  }
+  return node->integer;
+}
+
+std::optional<double> ElementRef::getDouble() const {
+  if (is(NodeType::Double)) {
+    return node->number;
+  }
+  if (is(NodeType::Integer)) {
+    return static_cast<double>(node->integer);
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string_view> ElementRef::getString() const {
+  if (!isString()) {
+    return std::nullopt;
+  }
+  return std::string_view(node->chars, node->size);
+}
+
+size_t ElementRef::size() const noexcept {
+  return isArray() || isObject() ? node->size : 0;
+}
+
+ElementRef ElementRef::operator[](size_t i) const {
+  if (!isArray() || i >= node->size) {
+    return ElementRef();
+  }
+  return ElementRef(node->children + i);
+}
+
+ElementRef ElementRef::operator[](std::string_view key) const {
+  if (!isObject()) {
+    return ElementRef();
+  }
+  for (size_t i = 0; i < node->size; i++) {
+    if (keyAt(i) == key) {
+      return valueAt(i);
+    }
+  }
+  return ElementRef();
+}
+
+ElementRef ElementRef::operator[](InternedKey key) const {
+  if (!isObject()) {
+    return ElementRef();
+  }
+  for (size_t i = 0; i < node->size; i++) {
+    const Node& k = node->children[2 * i];
+    if (k.chars == key.data() && k.size == key.view().size()) {
+      return valueAt(i);
+    }
+  }
+  return ElementRef();
+}
+
+std::string_view ElementRef::keyAt(size_t i) const {
+  if (!isObject() || i >= node->size) {
+    return {};
+  }
+  const Node& k = node->children[2 * i];
+  return std::string_view(k.chars, k.size);
+}
+
+ElementRef ElementRef::valueAt(size_t i) const {
+  if (!isObject() || i >= node->size) {
+    return ElementRef();
+  }
+  return ElementRef(node->children + 2 * i + 1);
+}
+
+JsonValue ElementRef::toJsonValue() const {
+  switch (type()) {
+    case NodeType::Null:
+      return JsonValue();
+    case NodeType::Bool:
+      return JsonValue(node->boolean);
+    case NodeType::Integer:
+      return JsonValue(node->integer);
+    case NodeType::Double:
+      return JsonValue(node->number);
+    case NodeType::String:
+      return JsonValue(std::string(node->chars, node->size));
+    case NodeType::Array: {
+      std::vector<JsonValue> values;
+      values.reserve(node->size);
+      for (size_t i = 0; i < node->size; i++) {
+        values.push_back((*this)[i].toJsonValue());
+      }
+      return JsonValue(std::move(values));
+    }
+    case NodeType::Object: {
+      JsonObject members;
+      members.reserve(node->size);
+      for (size_t i = 0; i < node->size; i++) {
+        members.insert_or_assign(keyAt(i),
+                                 valueAt(i).toJsonValue());
+      }
+      return JsonValue(std::move(members));
+    }
+    case NodeType::Invalid:
+      break;
+  }
+  return JsonValue();
+}
+
+namespace {
+// Collects finished nodes on a stack; when a container closes its children
+// are copied into the arena as one contiguous block.
+class DocumentBuilder {
+public:
+  DocumentBuilder(Arena& arena, KeyPool& keyPool)
+      : arena(arena), keyPool(keyPool) {}
+
+  bool beginArray() { return true; }
+  bool beginObject() { return true; }
+
+  bool endArray(size_t count) { return close(NodeType::Array, count, count); }
+
+  bool endObject(size_t count) {
+    return close(NodeType::Object, count, 2 * count);
+  }
+
+  bool key(std::string_view s) {
+    std::string_view interned = keyPool.intern(s).view();
+    Node node{NodeType::String, static_cast<uint32_t>(s.size()), {}};
+    node.chars = interned.data();
+    stack.push_back(node);
+    return true;
+  }
+
+  bool string(std::string_view s) {
+    char* chars = arena.allocateArray<char>(s.size());
+    std::memcpy(chars, s.data(), s.size());
+    Node node{NodeType::String, static_cast<uint32_t>(s.size()), {}};
+    node.chars = chars;
+    stack.push_back(node);
+    return true;
+  }
+
+  bool number(const ParsedNumber& n, std::string_view) {
+    Node node{NodeType::Integer, 0, {}};
+    if (auto i = std::get_if<int64_t>(&n.value)) {
+      node.integer = *i;
+    } else {
+      node.type = NodeType::Double;
+      node.number = std::get<double>(n.value);
+    }
+    stack.push_back(node);
+    return true;
+  }
+
+  bool boolean(bool b) {
+    Node node{NodeType::Bool, 0, {}};
+    node.boolean = b;
+    stack.push_back(node);
+    return true;
+  }
+
+  bool null() {
+    stack.push_back(Node{NodeType::Null, 0, {}});
+    return true;
+  }
+
+  const Node* finish() {
+    Node* root = arena.allocateArray<Node>(1);
+    *root = stack.back();
+    return root;
+  }
+
+private:
+  Arena& arena;
+  KeyPool& keyPool;
+  std::vector<Node> stack;
+
+  bool close(NodeType type, size_t count, size_t nodeCount) {
+    Node* children = arena.allocateArray<Node>(nodeCount);
+    size_t start = stack.size() - nodeCount;
+    std::copy(stack.begin() + static_cast<std::ptrdiff_t>(start), stack.end(),
+              children);
+    stack.resize(start);
+    Node node{type, static_cast<uint32_t>(count), {}};
+    node.children = children;
+    stack.push_back(node);
+    return true;
+  }
+};
+}  // namespace
+
+std::optional<Document> Document::fromString(std::string_view input) {
+  return parse(input, nullptr);
+}
+
+std::optional<Document> Document::fromString(std::string_view input,
+                                             KeyPool& pool) {
+  return parse(input, &pool);
+}
+
+std::optional<Document> Document::parse(std::string_view input,
+                                        KeyPool* pool) {
+  if (input.size() > UINT32_MAX) {
+    return std::nullopt;
+  }
+  // Start with about one arena byte per input byte, capped, and let the
+  // arena's doubling chunks follow the tree's real size: a large input that
+  // holds a small tree then reserves little, and even a multi-gigabyte tree
+  // takes only a dozen or so chunks.
+  Document doc(std::clamp<size_t>(input.size(), 4096, kMaxFirstChunk));
+  if (pool) {
+    doc.keyPool = pool;
+  } else {
+    doc.ownKeyPool = std::make_unique<KeyPool>();
+    doc.keyPool = doc.ownKeyPool.get();
+  }
+  DocumentBuilder builder(*doc.arena, *doc.keyPool);
+  detail::Reader<DocumentBuilder> reader(input, builder);
+  if (!reader.parseDocument()) {
+    return std::nullopt;
+  }
+  doc.rootNode = builder.finish();
+  return doc;
+}
+}  // namespace jerry
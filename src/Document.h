@@ -0,0 +1,151 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Arena.h"
+#include "Json.h"
+#include "KeyPool.h"
+
+namespace jerry {
+enum class NodeType : uint8_t {
+  Null,
+  Bool,
+  Integer,
+  Double,
+  String,
+  Array,
+  Object,
+  // The type of an invalid ElementRef; never stored in a Node.
+  Invalid
+};
+
+/**
+ * @brief A 16-byte tagged DOM record.
+ *
+ * Strings point at their bytes in the arena. Arrays point at `size`
+ * contiguous child nodes; objects point at `size` key/value pairs stored as
+ * 2 * size contiguous nodes (key, value, key, value, ...).
+ */
+struct Node {
+  NodeType type;
+  uint32_t size;
+  union {
+    bool boolean;
+    int64_t integer;
+    double number;
+    const char* chars;
+    const Node* children;
+  };
+};
+static_assert(sizeof(Node) == 16, "Node must stay a 16-byte record");
+
+/**
+ * @brief Read-only handle to a node of a Document.
+ *
+ * Mirrors JsonValue: the accessors return nullopt (or an invalid
+ * ElementRef) when the node holds a different type. Handles are only valid
+ * while their Document is alive.
+ */
+class ElementRef {
+public:
+  explicit ElementRef(const Node* node = nullptr) : node(node) {}
+
+  /** False for the handle returned by a failed lookup. **/
+  bool valid() const noexcept { return node != nullptr; }
+  explicit operator bool() const noexcept { return valid(); }
+
+  /** NodeType::Invalid for an invalid handle. **/
+  NodeType type() const noexcept {
+    return valid() ? node->type : NodeType::Invalid;
+  }
+  bool isNull() const noexcept { return is(NodeType::Null); }
+  bool isBool() const noexcept { return is(NodeType::Bool); }
+  bool isNumber() const noexcept {
+    return is(NodeType::Integer) || is(NodeType::Double);
+  }
+  bool isString() const noexcept { return is(NodeType::String); }
+  bool isArray() const noexcept { return is(NodeType::Array); }
+  bool isObject() const noexcept { return is(NodeType::Object); }
+
+  std::optional<bool> getBool() const;
+  /** The value of an integer node. **/
+  std::optional<int64_t> getInt64() const;
+  /** The value of any number node, converted to double if needed. **/
+  std::optional<double> getDouble() const;
+  std::optional<std::string_view> getString() const;
+
+  /** Element count for arrays, member count for objects, else 0. **/
+  size_t size() const noexcept;
+
+  /** The i-th array element; invalid if out of range or not an array. **/
+  ElementRef operator[](size_t i) const;
+  /** The member named key; invalid if missing or not an object. **/
+  ElementRef operator[](std::string_view key) const;
+  /** As above, comparing key pointers only. key must come from the pool
+   * the document was parsed with. **/
+  ElementRef operator[](InternedKey key) const;
+
+  /** Key and value of the i-th member of an object, in document order. **/
+  std::string_view keyAt(size_t i) const;
+  ElementRef valueAt(size_t i) const;
+
+  /** Deep copy into the heap-allocated JsonValue representation; null for
+   * an invalid handle. **/
+  JsonValue toJsonValue() const;
+
+  bool operator==(const JsonValue& other) const {
+    return valid() && toJsonValue() == other;
+  }
+
+private:
+  const Node* node;
+
+  bool is(NodeType t) const noexcept { return node && node->type == t; }
+};
+
+/**
+ * @brief A parsed JSON document whose nodes all live in one Arena.
+ *
+ * An alternative to Json for large documents: nodes are 16 bytes, strings
+ * and child lists are contiguous, and destroying the document frees the
+ * arena in bulk.
+ *
+ * Object keys are interned: each distinct key is stored once in a KeyPool
+ * and every occurrence points at that copy. By default the pool belongs to
+ * the document; documents sharing a schema can share one pool instead,
+ * which must then outlive them (and be thread-safe if they are parsed
+ * concurrently).
+ */
+class Document {
+public:
+  static std::optional<Document> fromString(std::string_view input);
+  /** Interns keys in pool rather than a pool of the document's own. **/
+  static std::optional<Document> fromString(std::string_view input,
+                                            KeyPool& pool);
+
+  ElementRef root() const { return ElementRef(rootNode); }
+
+  const Arena& getArena() const noexcept { return *arena; }
+  /** The pool holding this document's keys. **/
+  KeyPool& getKeyPool() const noexcept { return *keyPool; }
+
+private:
+  static constexpr size_t kMaxFirstChunk = 1 << 20;
+
+  explicit Document(size_t firstChunkSize)
+      : arena(std::make_unique<Arena>(firstChunkSize)) {}
+
+  static std::optional<Document> parse(std::string_view input,
+                                       KeyPool* pool);
+
+  // Heap-allocated so that moving a Document keeps node pointers valid.
+  std::unique_ptr<Arena> arena;
+  std::unique_ptr<KeyPool> ownKeyPool;
+  KeyPool* keyPool = nullptr;
+  const Node* rootNode = nullptr;
+};
+}  // namespace jerry
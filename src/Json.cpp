@@ -0,0 +1,666 @@
+#include "Json.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <latch>
+
+#include "KeyPool.h"
+#include "MappedFile.h"
+#include "Reader.h"
+#include "StringDecoder.h"
+#include "ThreadPool.h"
+#include "Writer.h"
+
+namespace jerry {
+namespace {
+// What a value starting with each byte can be.
+enum class ValueStart : uint8_t {
+  Invalid,
+  String,
+  Number,
+  Bool,
+  Null,
+  Array,
+  Object
+};
+
+constexpr std::array<ValueStart, 256> kValueStart = [] {
+  std::array<ValueStart, 256> table{};
+  table['"'] = ValueStart::String;
+  table['-'] = ValueStart::Number;
+  for (char c = '0'; c <= '9'; c++) {
+    table[static_cast<unsigned char>(c)] = ValueStart::Number;
+  }
+  table['t'] = ValueStart::Bool;
+  table['f'] = ValueStart::Bool;
+  table['n'] = ValueStart::Null;
+  table['['] = ValueStart::Array;
+  table['{'] = ValueStart::Object;
+  return table;
+}();
+
+// The tokenizers fromState dispatches to, built on first use.
+const auto& grammar() {
+  struct Grammar {
+    decltype(skipMany(whitespace())) spaces;
+    decltype(jsonString()) string;
+    decltype(jsonNumber()) number;
+    decltype(boolean()) literalBool;
+    decltype(jsonNull()) literalNull;
+  };
+  static const Grammar g{skipMany(whitespace()), jsonString(), jsonNumber(),
+                         boolean(), jsonNull()};
+  return g;
+}
+
+JsonKey makeKey(std::string_view text, KeyPool* keys) {
+  return keys ? keys->internJsonKey(text) : JsonKey(text);
+}
+
+void skipSpaces(TokenizerState& state) {
+  state = grammar().spaces.run(state)->second;
+}
+
+template <TokenizerLike P>
+std::optional<JsonValue> scalarFromState(const P& tokenizer,
+                                         TokenizerState& state) {
+  auto token = tokenizer.run(state);
+  if (!token) {
+    return std::nullopt;
+  }
+  state = token->second;
+  return JsonValue::fromJsonToken(std::move(token->first));
+}
+
+std::optional<std::vector<JsonValue>> listFromState(TokenizerState& state,
+                                                    size_t depth,
+                                                    KeyPool* keys);
+std::optional<JsonValue> objectFromState(TokenizerState& state, size_t depth,
+                                         KeyPool* keys);
+
+std::optional<JsonValue> valueFromState(TokenizerState& state, size_t depth,
+                                        KeyPool* keys) {
+  skipSpaces(state);
+  if (state.atEnd() || depth > Json::kMaxDepth) {
+    return std::nullopt;
+  }
+  const auto& g = grammar();
+  switch (kValueStart[static_cast<unsigned char>(state.currentCharacter())]) {
+    case ValueStart::String:
+      return scalarFromState(g.string, state);
+    case ValueStart::Number:
+      return scalarFromState(g.number, state);
+    case ValueStart::Bool:
+      return scalarFromState(g.literalBool, state);
+    case ValueStart::Null:
+      return scalarFromState(g.literalNull, state);
+    case ValueStart::Array: {
+      state = state.advance();
+      auto values = listFromState(state, depth + 1, keys);
+      if (!values) {
+        return std::nullopt;
+      }
+      return JsonValue(std::move(*values));
+    }
+    case ValueStart::Object:
+      state = state.advance();
+      return objectFromState(state, depth + 1, keys);
+    case ValueStart::Invalid:
+      break;
+  }
+  return std::nullopt;
+}
+
+// Consumes the separator after a member or element: true for ',', false for
+// the closing character, nullopt for anything else.
+std::optional<bool> nextMember(TokenizerState& state, char close) {
+  skipSpaces(state);
+  if (state.atEnd()) {
+    return std::nullopt;
+  }
+  char c = state.currentCharacter();
+  state = state.advance();
+  if (c == ',') {
+    return true;
+  }
+  if (c == close) {
+    return false;
+  }
+  return std::nullopt;
+}
+
+std::optional<std::vector<JsonValue>> listFromState(TokenizerState& state,
+                                                    size_t depth,
+                                                    KeyPool* keys) {
+  std::vector<JsonValue> values;
+  skipSpaces(state);
+  if (!state.atEnd() && state.currentCharacter() == ']') {
+    state = state.advance();
+    return values;
+  }
+  while (true) {
+    auto element = valueFromState(state, depth, keys);
+    if (!element) {
+      return std::nullopt;
+    }
+    values.push_back(std::move(*element));
+    auto more = nextMember(state, ']');
+    if (!more) {
+      return std::nullopt;
+    }
+    if (!*more) {
+      return values;
+    }
+  }
+}
+
+std::optional<JsonValue> objectFromState(TokenizerState& state, size_t depth,
+                                         KeyPool* keys) {
+  JsonObject objectMap;
+  skipSpaces(state);
+  if (!state.atEnd() && state.currentCharacter() == '}') {
+    state = state.advance();
+    return JsonValue(std::move(objectMap));
+  }
+  const auto& g = grammar();
+  while (true) {
+    skipSpaces(state);
+    auto key = g.string.run(state);
+    if (!key) {
+      return std::nullopt;
+    }
+    state = key->second;
+    skipSpaces(state);
+    if (state.atEnd() || state.currentCharacter() != ':') {
+      return std::nullopt;
+    }
+    state = state.advance();
+    auto member = valueFromState(state, depth, keys);
+    if (!member) {
+      return std::nullopt;
+    }
+    objectMap.insert_or_assign(
+        makeKey(std::get<std::string>(key->first.value), keys),
+        std::move(*member));
+    auto more = nextMember(state, '}');
+    if (!more) {
+      return std::nullopt;
+    }
+    if (!*more) {
+      return JsonValue(std::move(objectMap));
+    }
+  }
+}
+
+// Builds the tree for Json::fromString(input, resource). Finished values wait
+// on a stack that also lives in the resource until their container closes.
+// Strings are taken raw from the Reader and decoded straight into the
+// resource, skipping the Reader's scratch buffer.
+class PmrBuilder {
+public:
+  PmrBuilder(std::string_view input, std::pmr::memory_resource* resource)
+      : input(input), alloc(resource), stack(alloc) {}
+
+  bool beginArray() { return true; }
+  bool beginObject() { return true; }
+
+  bool endArray(size_t count) {
+    auto first = stack.end() - static_cast<std::ptrdiff_t>(count);
+    pmr::JsonArray values(alloc);
+    values.reserve(count);
+    std::move(first, stack.end(), std::back_inserter(values));
+    stack.erase(first, stack.end());
+    stack.emplace_back(std::move(values));
+    return true;
+  }
+
+  bool endObject(size_t count) {
+    auto first = stack.end() - static_cast<std::ptrdiff_t>(2 * count);
+    pmr::JsonObject members(alloc);
+    members.reserve(count);
+    for (auto it = first; it != stack.end(); it += 2) {
+      members.insert_or_assign(
+          std::move(std::get<std::pmr::string>(it->value)),
+          std::move(it[1]));
+    }
+    stack.erase(first, stack.end());
+    stack.emplace_back(std::move(members));
+    return true;
+  }
+
+  bool rawKey(size_t begin, size_t end, bool escaped) {
+    return rawString(begin, end, escaped);
+  }
+
+  bool rawString(size_t begin, size_t end, bool escaped) {
+    std::pmr::string s(alloc);
+    // The Reader has already checked the body's UTF-8, so decoding need not.
+    if (!escaped) {
+      s.assign(input.data() + begin, end - begin);
+    } else if (!decodeString(input, begin, s, end)) {
+      return false;
+    }
+    stack.emplace_back(std::move(s));
+    return true;
+  }
+
+  bool number(const ParsedNumber& n, std::string_view) {
+    std::visit([this](auto v) { stack.emplace_back(v); }, n.value);
+    return true;
+  }
+
+  bool boolean(bool b) {
+    stack.emplace_back(b);
+    return true;
+  }
+
+  bool null() {
+    stack.emplace_back();
+    return true;
+  }
+
+  pmr::JsonValue finish() { return std::move(stack.back()); }
+
+private:
+  std::string_view input;
+  pmr::JsonValue::allocator_type alloc;
+  std::pmr::vector<pmr::JsonValue> stack;
+};
+
+bool isWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// True if the token at index[i], which ends at end, is followed by nothing
+// but whitespace up to the next indexed position.
+bool endsToken(std::string_view input, const StructuralIndex& index, size_t i,
+               size_t end) {
+  size_t limit = i + 1 < index.size() ? index[i + 1] : input.size();
+  if (end > limit) {
+    return false;
+  }
+  for (; end < limit; end++) {
+    if (!isWhitespace(input[end])) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+std::optional<JsonValue> JsonValue::fromJsonToken(JsonToken token) {
+  switch (token.type) {
+    case JsonTokenType::Null:
+      return JsonValue();
+    case JsonTokenType::String:
+      return JsonValue(std::get<std::string>(std::move(token.value)));
+    case JsonTokenType::Boolean:
+      return JsonValue(std::get<bool>(token.value));
+    case JsonTokenType::Number:
+      if (const int64_t* n = std::get_if<int64_t>(&token.value)) {
+        return JsonValue(*n);
+      }
+      return JsonValue(std::get<double>(token.value));
+    default:
+      return std::nullopt;
+  }
+}
+
+std::string JsonValue::toString() const { return toJson(*this); }
+
+JsonValue pmr::JsonValue::toJsonValue() const {
+  return std::visit(
+      [](const auto& v) -> jerry::JsonValue {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::monostate>) {
+          return jerry::JsonValue();
+        } else if constexpr (std::is_same_v<T, std::pmr::string>) {
+          return jerry::JsonValue(std::string(v));
+        } else if constexpr (std::is_same_v<T, JsonArray>) {
+          std::vector<jerry::JsonValue> values;
+          values.reserve(v.size());
+          for (const auto& element : v) {
+            values.push_back(element.toJsonValue());
+          }
+          return jerry::JsonValue(std::move(values));
+        } else if constexpr (std::is_same_v<T, JsonObject>) {
+          jerry::JsonObject members;
+          members.reserve(v.size());
+          for (const auto& [key, member] : v) {
+            members.insert_or_assign(std::string_view(key),
+                                     member.toJsonValue());
+          }
+          return jerry::JsonValue(std::move(members));
+        } else {
+          return jerry::JsonValue(v);
+        }
+      },
+      value);
+}
+
+std::optional<pmr::JsonValue> Json::fromString(
+    std::string_view input, std::pmr::memory_resource* resource) {
+  PmrBuilder builder(input, resource);
+  detail::Reader<PmrBuilder> reader(input, builder);
+  if (!reader.parseDocument()) {
+    return std::nullopt;
+  }
+  return builder.finish();
+}
+
+std::optional<std::pair<std::vector<JsonValue>, TokenizerState>>
+Json::parseList(TokenizerState& state) {
+  auto values = listFromState(state, 1, nullptr);
+  if (!values) {
+    return std::nullopt;
+  }
+  return std::make_pair(std::move(*values), state);
+}
+
+std::optional<std::pair<Json, TokenizerState>> Json::fromState(
+    TokenizerState& state) {
+  auto value = valueFromState(state, 0, nullptr);
+  if (!value) {
+    return std::nullopt;
+  }
+  return std::make_pair(Json(std::move(*value)), state);
+}
+
+std::optional<std::pair<Json, TokenizerState>> Json::fromState(
+    TokenizerState& state, KeyPool& keys) {
+  auto value = valueFromState(state, 0, &keys);
+  if (!value) {
+    return std::nullopt;
+  }
+  return std::make_pair(Json(std::move(*value)), state);
+}
+
+std::optional<Json> Json::fromString(std::string_view input) {
+  auto index = StructuralIndex::build(input);
+  if (!index) {
+    return std::nullopt;
+  }
+  return fromIndex(input, *index, nullptr);
+}
+
+std::optional<Json> Json::fromString(std::string_view input, KeyPool& keys) {
+  auto index = StructuralIndex::build(input);
+  if (!index) {
+    return std::nullopt;
+  }
+  return fromIndex(input, *index, &keys);
+}
+
+std::optional<Json> Json::fromString(std::string_view input,
+                                     utf8::Policy policy) {
+  if (policy == utf8::Policy::Replace && !utf8::isValid(input)) {
+    return fromString(utf8::replaceInvalid(input));
+  }
+  return fromString(input);
+}
+
+std::optional<Json> Json::fromFile(const std::string& path) {
+  auto file = MappedFile::open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  return fromString(file->view());
+}
+
+std::optional<Json> Json::fromIndex(std::string_view input,
+                                   const StructuralIndex& index,
+                                   KeyPool* keys) {
+  if (index.empty()) {
+    return std::nullopt;
+  }
+  size_t i = 0;
+  auto value = valueAt(input, index, i, 0, keys);
+  if (!value || i != index.size()) {
+    return std::nullopt;
+  }
+  return Json(std::move(*value));
+}
+
+std::optional<std::vector<JsonValue>> Json::elementsBetween(
+    std::string_view input, const StructuralIndex& index, size_t begin,
+    size_t end, KeyPool* keys) {
+  std::vector<JsonValue> values;
+  size_t i = begin;
+  while (true) {
+    auto element = valueAt(input, index, i, 1, keys);
+    if (!element || i > end) {
+      return std::nullopt;
+    }
+    values.push_back(std::move(*element));
+    if (i == end) {
+      return values;
+    }
+    if (input[index[i]] != ',') {
+      return std::nullopt;
+    }
+    i++;
+  }
+}
+
+std::optional<JsonValue> Json::scalarAt(std::string_view input,
+                                       const StructuralIndex& index,
+                                       size_t& i) {
+  auto state = TokenizerState(input, index[i]);
+  TokenizerResult<JsonToken> token;
+  switch (input[index[i]]) {
+    case '"':
+      token = jsonString().run(state);
+      break;
+    case 't':
+    case 'f':
+      token = boolean().run(state);
+      break;
+    case 'n':
+      token = jsonNull().run(state);
+      break;
+    default:
+      token = jsonNumber().run(state);
+      break;
+  }
+  if (!token) {
+    return std::nullopt;
+  }
+  if (!endsToken(input, index, i, token->second.getPosition())) {
+    return std::nullopt;
+  }
+  i++;
+  return JsonValue::fromJsonToken(token->first);
+}
+
+std::optional<JsonKey> Json::keyAt(std::string_view input,
+                                   const StructuralIndex& index, size_t& i,
+                                   KeyPool* keys) {
+  // Most keys have no escapes and are read straight from the input; the
+  // others are decoded into a buffer first.
+  size_t begin = index[i] + 1;
+  size_t end = findStringSpecial(input, begin);
+  std::string decoded;
+  std::string_view text;
+  if (end < input.size() && input[end] == '"') {
+    text = input.substr(begin, end - begin);
+    if (!utf8::isValid(text)) {
+      return std::nullopt;
+    }
+    end++;
+  } else {
+    auto decodedEnd = decodeString(input, begin, decoded);
+    if (!decodedEnd) {
+      return std::nullopt;
+    }
+    text = decoded;
+    end = *decodedEnd;
+  }
+  if (!endsToken(input, index, i, end)) {
+    return std::nullopt;
+  }
+  i++;
+  return makeKey(text, keys);
+}
+
+std::optional<JsonValue> Json::valueAt(std::string_view input,
+                                      const StructuralIndex& index,
+                                      size_t& i, size_t depth,
+                                      KeyPool* keys) {
+  if (i >= index.size() || depth > kMaxDepth) {
+    return std::nullopt;
+  }
+  auto next = [&]() { return i < index.size() ? input[index[i]] : '\0'; };
+
+  switch (input[index[i]]) {
+    case '[': {
+      i++;
+      std::vector<JsonValue> values;
+      if (next() == ']') {
+        i++;
+        return JsonValue(std::move(values));
+      }
+      while (true) {
+        auto element = valueAt(input, index, i, depth + 1, keys);
+        if (!element) {
+          return std::nullopt;
+        }
+        values.push_back(std::move(*element));
+        char c = next();
+        i++;
+        if (c == ']') {
+          return JsonValue(std::move(values));
+        }
+        if (c != ',') {
+          return std::nullopt;
+        }
+      }
+    }
+    case '{': {
+      i++;
+      JsonObject objectMap;
+      if (next() == '}') {
+        i++;
+        return JsonValue(std::move(objectMap));
+      }
+      while (true) {
+        if (next() != '"') {
+          return std::nullopt;
+        }
+        auto key = keyAt(input, index, i, keys);
+        if (!key || next() != ':') {
+          return std::nullopt;
+        }
+        i++;
+        auto member = valueAt(input, index, i, depth + 1, keys);
+        if (!member) {
+          return std::nullopt;
+        }
+        objectMap.insert_or_assign(std::move(*key), std::move(*member));
+        char c = next();
+        i++;
+        if (c == '}') {
+          return JsonValue(std::move(objectMap));
+        }
+        if (c != ',') {
+          return std::nullopt;
+        }
+      }
+    }
+    case ']':
+    case '}':
+    case ':':
+    case ',':
+      return std::nullopt;
+    default:
+      return scalarAt(input, index, i);
+  }
+}
+
+std::optional<Json> Json::fromStringParallel(std::string_view input,
+                                             ThreadPool& pool,
+                                             size_t minSliceBytes) {
+  auto index = StructuralIndex::build(input);
+  if (!index) {
+    return std::nullopt;
+  }
+  size_t slices = std::min(pool.size() * 4,
+                           input.size() / std::max<size_t>(minSliceBytes, 1));
+  if (slices < 2 || index->size() < 3 || input[(*index)[0]] != '[' ||
+      input[(*index)[1]] == ']') {
+    return fromIndex(input, *index, nullptr);
+  }
+
+  // Walk the index once for the depth-1 commas, cutting a slice at the first
+  // one past each multiple of input.size() / slices. cuts holds the index
+  // position of each slice's terminating comma, then of the closing bracket.
+  std::vector<size_t> cuts;
+  size_t nextCut = input.size() / slices;
+  size_t depth = 0;
+  size_t i = 1;
+  for (; i < index->size(); i++) {
+    char c = input[(*index)[i]];
+    if (c == '[' || c == '{') {
+      depth++;
+    } else if (c == ']' || c == '}') {
+      if (depth == 0) {
+        break;
+      }
+      depth--;
+    } else if (c == ',' && depth == 0 && (*index)[i] >= nextCut) {
+      cuts.push_back(i);
+      nextCut = (*index)[i] + input.size() / slices;
+    }
+  }
+  // The root must close with the last token in the index.
+  if (i + 1 != index->size() || input[(*index)[i]] != ']') {
+    return std::nullopt;
+  }
+  cuts.push_back(i);
+
+  std::vector<std::optional<std::vector<JsonValue>>> parts(cuts.size());
+  // Slices after the first go to the pool; the caller parses the first one
+  // and then helps run queued tasks, so the parse finishes even when it is
+  // called from one of pool's own workers. An exception thrown by a slice
+  // is rethrown here once every slice has settled.
+  std::vector<std::exception_ptr> errors(cuts.size());
+  std::latch done(static_cast<std::ptrdiff_t>(cuts.size()));
+  auto parseSlice = [&](size_t s) {
+    size_t begin = s == 0 ? 1 : cuts[s - 1] + 1;
+    try {
+      parts[s] = elementsBetween(input, *index, begin, cuts[s], nullptr);
+    } catch (...) {
+      errors[s] = std::current_exception();
+    }
+    done.count_down();
+  };
+  for (size_t s = 1; s < cuts.size(); s++) {
+    pool.submit([&parseSlice, s] { parseSlice(s); });
+  }
+  parseSlice(0);
+  while (!done.try_wait() && pool.runPendingTask()) {
+  }
+  done.wait();
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  size_t total = 0;
+  for (const auto& part : parts) {
+    if (!part) {
+      return std::nullopt;
+    }
+    total += part->size();
+  }
+  std::vector<JsonValue> values;
+  values.reserve(total);
+  for (auto& part : parts) {
+    std::move(part->begin(), part->end(), std::back_inserter(values));
+  }
+  return Json(std::move(values));
+}
+}  // namespace jerry
@@ -1,26 +1,49 @@
+#pragma once
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
-#include <optional>
+#include <vector>
 
+#include "JsonKey.h"
+#include "JsonObject.h"
+#include "StructuralIndex.h"
 #include "Tokenizer.h"
+#include "Utf8.h"
 
 namespace jerry {
+class KeyPool;
+class ThreadPool;
+struct JsonValue;
+
+// Object members in document order; see JsonObject.h. Keys are JsonKeys,
+// which copies and interned keys share (see JsonKey.h).
+using JsonObject = BasicJsonObject<JsonValue, std::allocator<char>, JsonKey>;
 
 struct JsonValue {
   // JsonValues or either a literal (bool, string, etc...) or a mapping of a
   // key (std::string) to another value.
+  // Numbers are int64_t when they are exact integers, double otherwise.
   std::variant<std::monostate, bool, double, std::string, std::vector<JsonValue>,
-               std::unordered_map<std::string, JsonValue>>
+               JsonObject, int64_t>
       value;
   
   JsonValue() : value(std::monostate()) {}
   JsonValue(bool b) : value(b) {}
-  JsonValue(int n) : value((double) n) {}
+  JsonValue(int n) : value(static_cast<int64_t>(n)) {}
+  JsonValue(int64_t n) : value(n) {}
   JsonValue(double d) : value(d) {}
   JsonValue(const std::string& s) : value(s) {}
+  JsonValue(std::string&& s) : value(std::move(s)) {}
   JsonValue(const char* s) : value(std::string(s)) {}
   JsonValue(const std::vector<JsonValue>& v) : value(v) {}
-  JsonValue(const std::unordered_map<std::string, JsonValue>& m) : value(m) {}
+  JsonValue(std::vector<JsonValue>&& v) : value(std::move(v)) {}
+  JsonValue(const JsonObject& o) : value(o) {}
+  JsonValue(JsonObject&& o) : value(std::move(o)) {}
+  JsonValue(const std::unordered_map<std::string, JsonValue>& m)
+      : value(JsonObject(m)) {}
   
   JsonValue(std::initializer_list<std::string> strings) {
     std::vector<JsonValue> values;
@@ -31,258 +54,225 @@ struct JsonValue {
   }
   
   bool operator==(const JsonValue &other) const {
+    if (isNumber() && other.isNumber()) {
+      return JsonToken::numberEquals(value, other.value);
+    }
     return value == other.value;
   }
 
-  static std::optional<JsonValue> fromJsonToken(JsonToken token) {
-    if (token.type == JsonTokenType::Null) {
-      return JsonValue();
-    }
-    auto jVal = std::visit([](auto&& val) -> std::optional<JsonValue> {
-        using T = std::decay_t<decltype(val)>;
-        if constexpr (std::is_same_v<T, std::string>) {
-          return JsonValue(val);
-        }
-        if constexpr (std::is_same_v<T, double>) {
-          return JsonValue(val);
-        }
-        if constexpr (std::is_same_v<T, bool>) {
-          return JsonValue(val);
-        }
-        return std::nullopt;
-    }, token.value);
-    return jVal;
+  bool isNumber() const {
+    return std::holds_alternative<double>(value) ||
+           std::holds_alternative<int64_t>(value);
   }
 
-  std::optional<std::string> toString() const {
-    auto s = std::visit([](auto&& val) -> std::optional<std::string> {
-        using T = std::decay_t<decltype(val)>;
-        if constexpr (std::is_same_v<T, std::string>) {
-          return val;
-        }
-        if constexpr (std::is_same_v<T, double>) {
-          return std::to_string(val);
-        }
-        if constexpr (std::is_same_v<T, bool>) {
-          return std::to_string(val);
-        }
-        if constexpr (std::is_same_v<T, std::vector<JsonValue>>) {
-          return "array";
-        }
-        if constexpr (std::is_same_v<T, std::map<std::string, JsonValue>>) {
-          return "object";
-        }
-        return std::nullopt;
-    }, value);
-    return s;
-  }
+  // The value a scalar token stands for, or nullopt for a structural token.
+  static std::optional<JsonValue> fromJsonToken(JsonToken token);
+
+  // Compact JSON text for this value (see Writer.h).
+  std::string toString() const;
 };
 
-class Json {
- public:
-  bool operator==(const Json &other) const {
-    return value == other.getValue();
-  }
+namespace pmr {
+struct JsonValue;
+
+using JsonObject =
+    BasicJsonObject<JsonValue, std::pmr::polymorphic_allocator<char>>;
+using JsonArray = std::pmr::vector<JsonValue>;
+
+/**
+ * @brief A JsonValue whose strings, arrays and objects allocate from a
+ * std::pmr::memory_resource.
+ *
+ * The type is allocator-aware: a pmr array or object constructs its
+ * elements with its own resource, so a whole tree built by
+ * Json::fromString(input, resource) lives in that resource. As with the
+ * std::pmr containers, a plain copy uses the default resource and a move
+ * keeps the source's; pass an allocator to copy into a specific one.
+ */
+struct JsonValue {
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+  using Variant = std::variant<std::monostate, bool, double, std::pmr::string,
+                               JsonArray, JsonObject, int64_t>;
 
-  JsonValue getValue() const {
-    return value;
-  }
+  Variant value;
 
-  static std::optional<std::pair<std::vector<JsonValue>, TokenizerState>> parseList(TokenizerState& state) {
-    std::vector<JsonValue> values;
-    
-    // Skip whitespace
-    auto whitespacesResult = manyOf(whitespace()).run(state);
-    if (whitespacesResult) {
-      state = whitespacesResult->second;
-    }
-    
-    // Try to parse values until we hit the end of the array
-    while (true) {
-      // Check for end of array
-      auto endResult = arrayEnd().run(state);
-      if (endResult) {
-        // Array is complete, update state and return values
-        state = endResult->second;
-        return std::make_pair(values, state);
-      }
-      
-      auto innerJsonResult = Json::fromState(state);
-      if (!innerJsonResult) {
-        return std::nullopt;
-      }
-
-      auto innerJson = innerJsonResult.value().first;
-      state = innerJsonResult.value().second;
-      
-      
-      // Add value to our list and update state
-      values.push_back(innerJson.getValue());
-      
-      // Skip whitespace
-      whitespacesResult = manyOf(whitespace()).run(state);
-      if (whitespacesResult) {
-        state = whitespacesResult->second;
-      }
-      
-      // Check for comma
-      auto commaResult = comma().run(state);
-      if (!commaResult) {
-        // If no comma, must be end of array
-        endResult = arrayEnd().run(state);
-        if (endResult) {
-          // Array is complete, update state and return values
-          state = endResult->second;
-          return std::make_pair(values, state);
-        }
-        // Expected comma or end of array
-        return std::nullopt;
-      }
-      
-      // Found comma, update state and continue
-      state = commaResult->second;
-      
-      // Skip whitespace after comma
-      whitespacesResult = manyOf(whitespace()).run(state);
-      if (whitespacesResult) {
-        state = whitespacesResult->second;
-      }
+  JsonValue() : value(std::monostate()) {}
+  explicit JsonValue(const allocator_type&) : JsonValue() {}
+  JsonValue(bool b) : value(b) {}
+  JsonValue(int n) : value(static_cast<int64_t>(n)) {}
+  JsonValue(int64_t n) : value(n) {}
+  JsonValue(double d) : value(d) {}
+  JsonValue(std::pmr::string&& s) : value(std::move(s)) {}
+  JsonValue(JsonArray&& v) : value(std::move(v)) {}
+  JsonValue(JsonObject&& o) : value(std::move(o)) {}
+  JsonValue(std::pmr::string&& s, const allocator_type& alloc)
+      : value(std::in_place_type<std::pmr::string>, std::move(s), alloc) {}
+  JsonValue(JsonArray&& v, const allocator_type& alloc)
+      : value(std::in_place_type<JsonArray>, std::move(v), alloc) {}
+  JsonValue(JsonObject&& o, const allocator_type& alloc)
+      : value(std::in_place_type<JsonObject>, std::move(o), alloc) {}
+  JsonValue(std::string_view s, const allocator_type& alloc = {})
+      : value(std::pmr::string(s, alloc)) {}
+  JsonValue(const char* s, const allocator_type& alloc = {})
+      : JsonValue(std::string_view(s), alloc) {}
+
+  JsonValue(const JsonValue& other) = default;
+  JsonValue(JsonValue&& other) noexcept = default;
+  JsonValue& operator=(const JsonValue& other) = default;
+  JsonValue& operator=(JsonValue&& other) = default;
+
+  JsonValue(const JsonValue& other, const allocator_type& alloc)
+      : value(rebind(other.value, alloc)) {}
+  JsonValue(JsonValue&& other, const allocator_type& alloc)
+      : value(rebind(std::move(other.value), alloc)) {}
+
+  bool operator==(const JsonValue& other) const {
+    if (isNumber() && other.isNumber()) {
+      return JsonToken::numberEquals(value, other.value);
     }
+    return value == other.value;
   }
 
-  static std::optional<std::pair<Json, TokenizerState>> fromState(TokenizerState& state) {
-    auto consumeWhitespace = [](TokenizerState& state) {
-      auto r = manyOf(whitespace()).run(state);
-      // manyOf should not return nullopt ever but lets be safe.
-      return r ? r->second : state;
-    };
-
-    state = consumeWhitespace(state);
-
-    // Check if this is a bool
-    auto jsonBoolResult = boolean().run(state);
-    if (jsonBoolResult) {
-      auto jVal = JsonValue::fromJsonToken(jsonBoolResult->first);
-      if (jVal) {
-        return std::make_pair(Json(jVal.value()), jsonBoolResult->second);
-      }
-    }
-
-    auto jsonNullResult = jsonNull().run(state);
-    if(jsonNullResult) {
-      auto jVal = JsonValue::fromJsonToken(JsonToken::makeNull());
-      if (jVal) {
-        return std::make_pair(Json(jVal.value()), jsonNullResult->second);
-      }
-    }
-
-    // Check if this is a literal string
-    auto jsonStringResult = jsonString().run(state);
-    if (jsonStringResult) {
-      auto jVal = JsonValue::fromJsonToken(jsonStringResult->first);
-      if (jVal) {
-        return std::make_pair(Json(jVal.value()), jsonStringResult->second);
-      }
-    }
-    
-    // Check if this is a number
-    auto jsonNumberResult = jsonNumber().run(state);
-    if (jsonNumberResult) {
-      auto jVal = JsonValue::fromJsonToken(jsonNumberResult->first);
-      if (jVal) {
-        return std::make_pair(Json(jVal.value()), jsonNumberResult->second);
-      }
-    }
+  bool isNumber() const {
+    return std::holds_alternative<double>(value) ||
+           std::holds_alternative<int64_t>(value);
+  }
 
-    // Check if this is a list
-    auto arrayStartResult = arrayStart().run(state);
-    if (arrayStartResult) {
-      state = arrayStartResult->second;
-      auto parseListResult = parseList(state);
-      if (!parseListResult) {
-        return std::nullopt;
-      }
-      return std::make_pair(Json(parseListResult->first), parseListResult->second);
-    }
+  // A copy of this value on the default heap.
+  jerry::JsonValue toJsonValue() const;
 
-    // Check if json.
-    auto objectStartResult = objectStart().run(state);
-    if (objectStartResult)  {
-      state = objectStartResult->second;
-      std::unordered_map<std::string, JsonValue> objectMap;
-
-      // Empty objects are valid
-      auto objectCloseResult = objectEnd().run(state);
-      if (objectCloseResult) {
-        return std::make_pair(Json(JsonValue(objectMap)), state);
-      }
-
-      bool continueObjectParsing = true;
-      while (continueObjectParsing) {
-        state = consumeWhitespace(state);
-        // Next should be a key (string)
-        // TODO write "consume" func in Tokenizer that does this.
-        auto keyResult = jsonString().run(state);
-        if (!keyResult) {
-          return std::nullopt;
-        }
-        state = keyResult->second;
-        state = consumeWhitespace(state);
-        auto colonResult = colon().run(state);
-        if (!colonResult) {
-          return std::nullopt;
-        }
-        state = colonResult->second;
-        state = consumeWhitespace(state);
-
-        //Recurse
-        auto innerJsonResult = fromState(state);
-        if (!innerJsonResult) {
-          return std::nullopt;
-        }
-
-        state = innerJsonResult->second;
-
-        objectMap[keyResult->first.toString().value()] = innerJsonResult->first.getValue();
-
-        auto commaResult = comma().run(state);
-        if (commaResult) {
-          state = commaResult->second;
-        } else {
-          continueObjectParsing = false;
-        }
-
-      }
-
-      state = consumeWhitespace(state);
-
-      auto closingBraceResult = braceClose().run(state);
-      if (!closingBraceResult) {
-        return std::nullopt;
-      }
-      state = closingBraceResult->second;
-
-      return std::make_pair(Json(JsonValue(objectMap)), state);
-    }
+ private:
+  // Copies or moves v, giving whichever alternative it holds alloc.
+  template <typename V>
+  static Variant rebind(V&& v, const allocator_type& alloc) {
+    return std::visit(
+        [&](auto&& alternative) -> Variant {
+          using T = std::remove_cvref_t<decltype(alternative)>;
+          if constexpr (std::uses_allocator_v<T, allocator_type>) {
+            return Variant(std::in_place_type<T>,
+                           std::forward<decltype(alternative)>(alternative),
+                           alloc);
+          } else {
+            return Variant(std::in_place_type<T>, alternative);
+          }
+        },
+        std::forward<V>(v));
+  }
+};
+}  // namespace pmr
 
-    return std::nullopt;
+class Json {
+ public:
+  bool operator==(const Json &other) const {
+    return value == other.value;
   }
 
+  JsonValue getValue() const & {
+    return value;
+  }
 
-  static std::optional<Json> fromString(const std::string& input) {
-    auto state = TokenizerState(input, 0);
-    auto result = fromState(state);
-    if (!result) {
-      return std::nullopt;
-    }
-    return result->first;
+  // Moves the value out of a Json that is about to be discarded.
+  JsonValue getValue() && {
+    return std::move(value);
   }
 
-  explicit Json(JsonValue v) : value(v) {};
-  explicit Json(std::vector<JsonValue> v) : value(JsonValue{v}) {};
+  // Parses the elements of an array whose '[' has already been consumed, up
+  // to and including the closing ']'.
+  static std::optional<std::pair<std::vector<JsonValue>, TokenizerState>> parseList(TokenizerState& state);
+
+  // Parses one value with the tokenizer combinators, leaving state just past
+  // it. The parser is predictive: the first non-whitespace byte picks the
+  // only grammar that can match, so nothing is tried and backtracked, and
+  // the tokenizers themselves are built once per process.
+  static std::optional<std::pair<Json, TokenizerState>> fromState(TokenizerState& state);
+
+  // As above, interning object keys in keys as fromString(input, keys) does.
+  static std::optional<std::pair<Json, TokenizerState>> fromState(
+      TokenizerState& state, KeyPool& keys);
+
+  // The input is only viewed while parsing; the resulting Json owns copies of
+  // everything it needs, so the buffer may be released afterwards.
+  //
+  // Parsing runs in two passes: StructuralIndex locates every token, then the
+  // DOM is built by walking the index. Only strings, numbers and literals go
+  // through the tokenizers; structure is read straight from the index.
+  static std::optional<Json> fromString(std::string_view input);
+
+  // Strings must be well-formed UTF-8, and \u escapes must decode to it, so
+  // an unpaired \uD800 is rejected too. With utf8::Policy::Replace,
+  // ill-formed bytes in raw input are instead replaced by U+FFFD before
+  // parsing, which costs a copy of the input only when it actually holds
+  // some; escapes are never replaced.
+  static std::optional<Json> fromString(std::string_view input,
+                                        utf8::Policy policy);
+
+  // Interns every object key in keys, so repeated keys, such as the field
+  // names of an array of records, share one immutable buffer instead of each
+  // object holding its own copy. The Json keeps the buffers alive and may
+  // outlive the pool; keys.stats() reports what sharing saved. Reusing one
+  // pool across documents shares their keys too. A pool used by several
+  // threads at once must be thread-safe (see KeyPool.h).
+  static std::optional<Json> fromString(std::string_view input, KeyPool& keys);
+
+  // Parses input into a pmr::JsonValue whose every node, key and string is
+  // allocated from resource, e.g. a std::pmr::monotonic_buffer_resource
+  // over a stack buffer. Strings are decoded straight into the resource and
+  // the parser's own stack lives there too, so when the resource has room
+  // the whole parse makes no call to the global allocator.
+  static std::optional<pmr::JsonValue> fromString(
+      std::string_view input, std::pmr::memory_resource* resource);
+
+  // Parses a file straight from a read-only memory mapping, without reading
+  // it into a string first.
+  static std::optional<Json> fromFile(const std::string& path);
+
+  // Like fromString, but a top-level array is split into slices of whole
+  // elements that are parsed on pool and joined in order. Element boundaries
+  // come from the structural index, so splitting is never speculative; other
+  // documents, and arrays too small to give each slice minSliceBytes, are
+  // parsed on the calling thread.
+  static std::optional<Json> fromStringParallel(
+      std::string_view input, ThreadPool& pool,
+      size_t minSliceBytes = kMinSliceBytes);
+
+  static constexpr size_t kMinSliceBytes = 64 << 10;
+
+  explicit Json(JsonValue v) : value(std::move(v)) {};
+  explicit Json(std::vector<JsonValue> v) : value(JsonValue{std::move(v)}) {};
+
+  // Containers nested deeper than this are rejected rather than risking the
+  // stack.
+  static constexpr size_t kMaxDepth = 1024;
 
  private:
   JsonValue value;
+
+  // The walkers below intern object keys in keys when it is not null.
+  static std::optional<Json> fromIndex(std::string_view input,
+                                       const StructuralIndex& index,
+                                       KeyPool* keys);
+
+  // Parses the elements of an array between index[begin] and the separator
+  // at index[end], which must be exactly the elements' commas.
+  static std::optional<std::vector<JsonValue>> elementsBetween(
+      std::string_view input, const StructuralIndex& index, size_t begin,
+      size_t end, KeyPool* keys);
+
+  // Parses the string, number or literal starting at index[i]. The token must
+  // end before the next indexed position with nothing but whitespace between.
+  static std::optional<JsonValue> scalarAt(std::string_view input,
+                                           const StructuralIndex& index,
+                                           size_t& i);
+
+  // Reads the object key at index[i], which is followed by its ':'.
+  static std::optional<JsonKey> keyAt(std::string_view input,
+                                      const StructuralIndex& index, size_t& i,
+                                      KeyPool* keys);
+
+  static std::optional<JsonValue> valueAt(std::string_view input,
+                                          const StructuralIndex& index,
+                                          size_t& i, size_t depth,
+                                          KeyPool* keys);
 };
 
 }  // namespace jerry
@@ -0,0 +1,40 @@
+#include "JsonKey.h"
+
+#include <new>
+
+namespace jerry {
+JsonKey::JsonKey(std::string_view key) {
+  if (key.size() <= kInlineSize) {
+    tag = static_cast<uint8_t>(key.size());
+    std::memcpy(small, key.data(), key.size());
+    small[key.size()] = '\0';
+  } else {
+    tag = kShared;
+    rep = allocate(key);
+  }
+}
+
+JsonKey JsonKey::share(std::string_view key) {
+  JsonKey shared;
+  shared.tag = kShared;
+  shared.rep = allocate(key);
+  return shared;
+}
+
+JsonKey::Rep* JsonKey::allocate(std::string_view key) {
+  void* memory = ::operator new(sizeof(Rep) + key.size() + 1);
+  Rep* rep = new (memory) Rep{{1}, key.size(),
+                              std::hash<std::string_view>()(key)};
+  char* chars = reinterpret_cast<char*>(rep + 1);
+  std::memcpy(chars, key.data(), key.size());
+  chars[key.size()] = '\0';
+  return rep;
+}
+
+void JsonKey::release(Rep* rep) noexcept {
+  if (rep->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    rep->~Rep();
+    ::operator delete(rep);
+  }
+}
+}  // namespace jerry
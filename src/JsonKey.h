@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace jerry {
+class KeyPool;
+
+/**
+ * @brief An immutable object key of the Json DOM.
+ *
+ * A key of up to kInlineSize bytes is stored in the JsonKey itself, as a
+ * std::string would store it. A longer key, and every key handed out by
+ * KeyPool::internJsonKey, lives in a reference-counted buffer that copies
+ * share; the buffer also remembers the key's hash. Keys that share a buffer
+ * compare equal without looking at the characters.
+ *
+ * The characters are followed by a '\0'.
+ */
+class JsonKey {
+public:
+  static constexpr size_t kInlineSize = 15;
+
+  JsonKey() noexcept : tag(0) { small[0] = '\0'; }
+  JsonKey(std::string_view key);
+  JsonKey(const std::string& key) : JsonKey(std::string_view(key)) {}
+  JsonKey(const char* key) : JsonKey(std::string_view(key)) {}
+
+  JsonKey(const JsonKey& other) noexcept : tag(other.tag) {
+    if (tag == kShared) {
+      rep = other.rep;
+      rep->refs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      std::memcpy(small, other.small, sizeof small);
+    }
+  }
+
+  JsonKey(JsonKey&& other) noexcept : tag(other.tag) {
+    std::memcpy(small, other.small, sizeof small);
+    other.tag = 0;
+    other.small[0] = '\0';
+  }
+
+  JsonKey& operator=(JsonKey other) noexcept {
+    std::swap(small, other.small);
+    std::swap(tag, other.tag);
+    return *this;
+  }
+
+  ~JsonKey() {
+    if (tag == kShared) {
+      release(rep);
+    }
+  }
+
+  const char* data() const noexcept {
+    return tag == kShared ? rep->chars() : small;
+  }
+  const char* c_str() const noexcept { return data(); }
+  size_t size() const noexcept { return tag == kShared ? rep->size : tag; }
+  bool empty() const noexcept { return size() == 0; }
+  char operator[](size_t i) const noexcept { return data()[i]; }
+
+  std::string_view view() const noexcept { return {data(), size()}; }
+  operator std::string_view() const noexcept { return view(); }
+
+  /** True if the characters are in a buffer shared by copies. **/
+  bool shared() const noexcept { return tag == kShared; }
+
+  /** std::hash of the characters, read from the buffer when shared. **/
+  size_t hash() const noexcept {
+    return tag == kShared ? rep->hash : std::hash<std::string_view>()(view());
+  }
+
+  friend bool operator==(const JsonKey& a, const JsonKey& b) noexcept {
+    if (a.tag == kShared && b.tag == kShared && a.rep == b.rep) {
+      return true;
+    }
+    return a.view() == b.view();
+  }
+
+  template <typename T>
+    requires(std::convertible_to<const T&, std::string_view> &&
+             !std::same_as<T, JsonKey>)
+  friend bool operator==(const JsonKey& a, const T& b) noexcept {
+    return a.view() == std::string_view(b);
+  }
+
+  friend auto operator<=>(const JsonKey& a, const JsonKey& b) noexcept {
+    return a.view() <=> b.view();
+  }
+
+private:
+  struct Rep {
+    std::atomic<uint32_t> refs;
+    size_t size;
+    size_t hash;
+
+    const char* chars() const noexcept {
+      return reinterpret_cast<const char*>(this + 1);
+    }
+  };
+
+  static constexpr uint8_t kShared = 0xff;
+
+  // Sixteen bytes of characters or a buffer pointer, then the inline length
+  // or kShared: 24 bytes in all, against std::string's 32.
+  union {
+    char small[kInlineSize + 1];
+    Rep* rep;
+  };
+  uint8_t tag;
+
+  // A key in a buffer of its own, however short.
+  static JsonKey share(std::string_view key);
+  static Rep* allocate(std::string_view key);
+  static void release(Rep* rep) noexcept;
+
+  friend class KeyPool;
+};
+}  // namespace jerry
+
+template <> struct std::hash<jerry::JsonKey> {
+  size_t operator()(const jerry::JsonKey& key) const noexcept {
+    return key.hash();
+  }
+};
@@ -0,0 +1,265 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace jerry {
+/**
+ * @brief The members of a JSON object, in document order.
+ *
+ * Members are stored as one contiguous vector of key/value pairs, so small
+ * objects cost a single allocation and iterate without chasing pointers.
+ * Lookups scan linearly until the object grows past kIndexThreshold
+ * members; from then on an open-addressing table of member positions is
+ * kept alongside. The table is built when an insert crosses the threshold,
+ * never by a lookup, so const access is safe from several threads.
+ *
+ * Inserting an existing key replaces its value in place, as a map did with
+ * duplicate keys. Equality ignores member order.
+ *
+ * A template so that it can be declared before Value is complete; see
+ * JsonObject in Json.h. Members and the index come from Allocator (rebound
+ * as needed), and so do the keys unless Key says otherwise; with a
+ * std::pmr::polymorphic_allocator the object is allocator-aware, so a
+ * containing pmr vector or object passes its resource down to it. A Key
+ * with a hash() member, such as JsonKey, supplies the hash the index uses.
+ */
+template <typename Value, typename Allocator = std::allocator<char>,
+          typename Key = std::basic_string<
+              char, std::char_traits<char>,
+              typename std::allocator_traits<
+                  Allocator>::template rebind_alloc<char>>>
+class BasicJsonObject {
+  template <typename T>
+  using Rebind =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+public:
+  using allocator_type = Allocator;
+  using key_type = Key;
+  using value_type = std::pair<key_type, Value>;
+
+private:
+  using Members = std::vector<value_type, Rebind<value_type>>;
+
+public:
+  using iterator = typename Members::iterator;
+  using const_iterator = typename Members::const_iterator;
+
+  static constexpr size_t kIndexThreshold = 8;
+
+  BasicJsonObject() = default;
+
+  explicit BasicJsonObject(const allocator_type& alloc)
+      : members(alloc), slots(alloc) {}
+
+  BasicJsonObject(const BasicJsonObject& other) = default;
+  BasicJsonObject(BasicJsonObject&& other) noexcept = default;
+  BasicJsonObject& operator=(const BasicJsonObject& other) = default;
+  BasicJsonObject& operator=(BasicJsonObject&& other) = default;
+
+  BasicJsonObject(const BasicJsonObject& other, const allocator_type& alloc)
+      : members(other.members, alloc), slots(other.slots, alloc) {}
+
+  BasicJsonObject(BasicJsonObject&& other, const allocator_type& alloc)
+      : members(std::move(other.members), alloc),
+        slots(std::move(other.slots), alloc) {}
+
+  BasicJsonObject(std::initializer_list<value_type> init) {
+    reserve(init.size());
+    for (const auto& [key, value] : init) {
+      insert_or_assign(key, value);
+    }
+  }
+
+  /** Members in the map's iteration order. **/
+  template <typename MapKey>
+  BasicJsonObject(const std::unordered_map<MapKey, Value>& map) {
+    reserve(map.size());
+    for (const auto& [key, value] : map) {
+      insert_or_assign(key, value);
+    }
+  }
+
+  allocator_type get_allocator() const noexcept {
+    return members.get_allocator();
+  }
+
+  size_t size() const noexcept { return members.size(); }
+  bool empty() const noexcept { return members.empty(); }
+  void reserve(size_t n) { members.reserve(n); }
+
+  iterator begin() noexcept { return members.begin(); }
+  iterator end() noexcept { return members.end(); }
+  const_iterator begin() const noexcept { return members.begin(); }
+  const_iterator end() const noexcept { return members.end(); }
+
+  /** The member named key, or end(). **/
+  iterator find(std::string_view key) {
+    return begin() + static_cast<std::ptrdiff_t>(indexOf(key));
+  }
+  const_iterator find(std::string_view key) const {
+    return begin() + static_cast<std::ptrdiff_t>(indexOf(key));
+  }
+  bool contains(std::string_view key) const { return indexOf(key) < size(); }
+
+  /** The value of the member named key; throws std::out_of_range if
+   * missing, like the map it replaces. **/
+  const Value& at(std::string_view key) const {
+    size_t i = indexOf(key);
+    if (i == size()) {
+      throw std::out_of_range("JsonObject::at");
+    }
+    return members[i].second;
+  }
+
+  /** The value of the member named key, adding a null one if missing. **/
+  Value& operator[](std::string_view key) {
+    size_t i = indexOf(key);
+    if (i == size()) {
+      append(makeKey(key), Value());
+    }
+    return members[i].second;
+  }
+
+  /** Adds key or replaces its value. The bool is true if it was added. **/
+  std::pair<iterator, bool> insert_or_assign(key_type key, Value value) {
+    size_t i = indexOf(key);
+    if (i < size()) {
+      members[i].second = std::move(value);
+      return {begin() + static_cast<std::ptrdiff_t>(i), false};
+    }
+    append(std::move(key), std::move(value));
+    return {end() - 1, true};
+  }
+
+  /** Removes the member named key, keeping the others in order. **/
+  size_t erase(std::string_view key) {
+    size_t i = indexOf(key);
+    if (i == size()) {
+      return 0;
+    }
+    members.erase(members.begin() + static_cast<std::ptrdiff_t>(i));
+    rebuildIndex();
+    return 1;
+  }
+
+  bool operator==(const BasicJsonObject& other) const {
+    if (size() != other.size()) {
+      return false;
+    }
+    for (const auto& [key, value] : members) {
+      auto match = other.find(key);
+      if (match == other.end() || !(match->second == value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  Members members;
+  // Open-addressing table of member position + 1 (0 marks an empty slot),
+  // sized to a power of two at most half full. Empty below kIndexThreshold.
+  std::vector<uint32_t, Rebind<uint32_t>> slots;
+
+  static size_t hash(std::string_view key) {
+    return std::hash<std::string_view>()(key);
+  }
+
+  static size_t hash(const key_type& key) {
+    if constexpr (requires { key.hash(); }) {
+      return key.hash();
+    } else {
+      return hash(std::string_view(key));
+    }
+  }
+
+  key_type makeKey(std::string_view key) const {
+    if constexpr (std::uses_allocator_v<key_type, allocator_type>) {
+      return key_type(key, get_allocator());
+    } else {
+      return key_type(key);
+    }
+  }
+
+  // Position of key, or size() if absent.
+  size_t indexOf(std::string_view key) const {
+    if (!slots.empty()) {
+      return probe(key);
+    }
+    const value_type* member = members.data();
+    size_t count = members.size();
+    size_t length = key.size();
+    // Length and last byte reject nearly every mismatch, including keys that
+    // share a prefix ("field1", "field2"), before any memcmp. Keys that share
+    // storage, as interned ones do, match on the pointer alone.
+    char last = length ? key[length - 1] : '\0';
+    for (size_t i = 0; i < count; i++) {
+      const key_type& k = member[i].first;
+      if (k.size() == length &&
+          (k.data() == key.data() || length == 0 ||
+           (k[length - 1] == last &&
+            std::memcmp(k.data(), key.data(), length) == 0))) {
+        return i;
+      }
+    }
+    return count;
+  }
+
+  size_t probe(std::string_view key) const {
+    size_t mask = slots.size() - 1;
+    for (size_t s = hash(key) & mask;; s = (s + 1) & mask) {
+      uint32_t slot = slots[s];
+      if (slot == 0) {
+        return members.size();
+      }
+      if (members[slot - 1].first == key) {
+        return slot - 1;
+      }
+    }
+  }
+
+  void append(key_type key, Value value) {
+    members.emplace_back(std::move(key), std::move(value));
+    if (members.size() <= kIndexThreshold) {
+      return;
+    }
+    if (2 * members.size() > slots.size()) {
+      rebuildIndex();
+    } else {
+      place(members.size() - 1);
+    }
+  }
+
+  void place(size_t i) {
+    size_t mask = slots.size() - 1;
+    size_t s = hash(members[i].first) & mask;
+    while (slots[s] != 0) {
+      s = (s + 1) & mask;
+    }
+    slots[s] = static_cast<uint32_t>(i + 1);
+  }
+
+  void rebuildIndex() {
+    slots.clear();
+    if (members.size() <= kIndexThreshold) {
+      return;
+    }
+    slots.resize(std::bit_ceil(4 * members.size()));
+    for (size_t i = 0; i < members.size(); i++) {
+      place(i);
+    }
+  }
+};
+}  // namespace jerry
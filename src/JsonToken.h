@@ -1,7 +1,10 @@
 #pragma once
+#include <cstdint>
+#include <optional>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <variant>
 
 namespace jerry {
@@ -21,17 +24,22 @@ enum class JsonTokenType {
 struct JsonToken {
   // TODO JsonTokenType and value should be private.
   JsonTokenType type;
-  std::variant<std::monostate, std::string, double, bool> value;
+  // Numbers are int64_t when they are exact integers, double otherwise.
+  std::variant<std::monostate, std::string, double, bool, int64_t> value;
 
   // Factory methods for creating tokens
-  static JsonToken fromString(const std::string &s) {
-    return {JsonTokenType::String, s};
+  static JsonToken fromString(std::string s) {
+    return {JsonTokenType::String, std::move(s)};
   }
 
   static JsonToken fromBool(bool b) { return {JsonTokenType::Boolean, b}; }
 
   static JsonToken fromNumber(double n) { return {JsonTokenType::Number, n}; }
 
+  static JsonToken fromInteger(int64_t n) {
+    return {JsonTokenType::Number, n};
+  }
+
   static JsonToken makeNull() {
     return {JsonTokenType::Null, std::monostate{}};
   }
@@ -51,9 +59,45 @@ struct JsonToken {
         type == JsonTokenType::Comma || type == JsonTokenType::Null) {
       return true;
     }
+    if (type == JsonTokenType::Number) {
+      return numberEquals(value, other.value);
+    }
     return value == other.value;
   }
 
+  // Numbers compare by value regardless of representation, so
+  // fromNumber(3) == fromInteger(3). Mixed comparisons are exact: a double
+  // never equals an integer it merely rounds to.
+  template <typename Variant>
+  static bool numberEquals(const Variant &a, const Variant &b) {
+    const int64_t *ai = std::get_if<int64_t>(&a);
+    const int64_t *bi = std::get_if<int64_t>(&b);
+    const double *ad = std::get_if<double>(&a);
+    const double *bd = std::get_if<double>(&b);
+    if (ai && bi) {
+      return *ai == *bi;
+    }
+    if (ad && bd) {
+      return *ad == *bd;
+    }
+    if (ai && bd) {
+      return integerEqualsDouble(*ai, *bd);
+    }
+    if (ad && bi) {
+      return integerEqualsDouble(*bi, *ad);
+    }
+    return false;
+  }
+
+  static bool integerEqualsDouble(int64_t i, double d) {
+    // [-2^63, 2^63) is exactly the range of doubles that convert to int64_t.
+    if (!(d >= -9223372036854775808.0 && d < 9223372036854775808.0)) {
+      return false;
+    }
+    auto truncated = static_cast<int64_t>(d);
+    return static_cast<double>(truncated) == d && truncated == i;
+  }
+
   std::optional<std::string> toString() const {
     if (std::holds_alternative<std::string>(value)) {
       return std::get<std::string>(value);
@@ -65,6 +109,16 @@ struct JsonToken {
     if (std::holds_alternative<double>(value)) {
       return std::get<double>(value);
     }
+    if (std::holds_alternative<int64_t>(value)) {
+      return static_cast<double>(std::get<int64_t>(value));
+    }
+    return std::nullopt;
+  }
+
+  std::optional<int64_t> toInteger() const {
+    if (std::holds_alternative<int64_t>(value)) {
+      return std::get<int64_t>(value);
+    }
     return std::nullopt;
   }
 
@@ -94,6 +148,8 @@ struct JsonToken {
       case JsonTokenType::Number:
         if (std::holds_alternative<double>(value)) {
           ss << "Number(" << std::get<double>(value) << ")";
+        } else if (std::holds_alternative<int64_t>(value)) {
+          ss << "Number(" << std::get<int64_t>(value) << ")";
         } else {
           ss << "Number(invalid)";
         }
@@ -0,0 +1,79 @@
+#include "KeyPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace jerry {
+InternedKey KeyPool::intern(std::string_view key) {
+  lookups.fetch_add(1, std::memory_order_relaxed);
+  bytesRequested.fetch_add(key.size(), std::memory_order_relaxed);
+  if (auto found = find(key)) {
+    return *found;
+  }
+  std::unique_lock lock(mutex, std::defer_lock);
+  if (threadSafe) {
+    lock.lock();
+    // Another thread may have added it since find() released the lock.
+    if (auto found = keys.find(key); found != keys.end()) {
+      return InternedKey(*found);
+    }
+  }
+  // At least one byte, so that even the empty key has an address no later
+  // key can share.
+  char* chars = arena.allocateArray<char>(std::max<size_t>(key.size(), 1));
+  std::memcpy(chars, key.data(), key.size());
+  std::string_view stored(chars, key.size());
+  keys.insert(stored);
+  bytesStored += key.size();
+  return InternedKey(stored);
+}
+
+JsonKey KeyPool::internJsonKey(std::string_view key) {
+  lookups.fetch_add(1, std::memory_order_relaxed);
+  bytesRequested.fetch_add(key.size(), std::memory_order_relaxed);
+  {
+    std::shared_lock lock(mutex, std::defer_lock);
+    if (threadSafe) {
+      lock.lock();
+    }
+    if (auto found = jsonKeys.find(key); found != jsonKeys.end()) {
+      return *found;
+    }
+  }
+  std::unique_lock lock(mutex, std::defer_lock);
+  if (threadSafe) {
+    lock.lock();
+    // Another thread may have added it since the shared lock was released.
+    if (auto found = jsonKeys.find(key); found != jsonKeys.end()) {
+      return *found;
+    }
+  }
+  bytesStored += key.size();
+  return *jsonKeys.insert(JsonKey::share(key)).first;
+}
+
+std::optional<InternedKey> KeyPool::find(std::string_view key) const {
+  std::shared_lock lock(mutex, std::defer_lock);
+  if (threadSafe) {
+    lock.lock();
+  }
+  if (auto found = keys.find(key); found != keys.end()) {
+    return InternedKey(*found);
+  }
+  return std::nullopt;
+}
+
+KeyPoolStats KeyPool::stats() const {
+  std::shared_lock lock(mutex, std::defer_lock);
+  if (threadSafe) {
+    lock.lock();
+  }
+  KeyPoolStats stats;
+  stats.lookups = lookups.load(std::memory_order_relaxed);
+  stats.unique = keys.size() + jsonKeys.size();
+  stats.bytesStored = bytesStored;
+  stats.bytesRequested = bytesRequested.load(std::memory_order_relaxed);
+  return stats;
+}
+}  // namespace jerry
@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_set>
+
+#include "Arena.h"
+#include "JsonKey.h"
+
+namespace jerry {
+/**
+ * @brief A canonical, immutable key from a KeyPool.
+ *
+ * Two InternedKeys from the same pool are equal exactly when they point at
+ * the same bytes, so comparison and hashing never look at the characters.
+ * Every key, the empty one included, has storage of its own.
+ */
+class InternedKey {
+public:
+  std::string_view view() const noexcept { return key; }
+  const char* data() const noexcept { return key.data(); }
+
+  bool operator==(const InternedKey& other) const noexcept {
+    return key.data() == other.key.data() && key.size() == other.key.size();
+  }
+
+private:
+  explicit InternedKey(std::string_view key) : key(key) {}
+
+  std::string_view key;
+
+  friend class KeyPool;
+};
+
+struct KeyPoolStats {
+  /** Calls to intern() and internJsonKey(). **/
+  size_t lookups = 0;
+  /** Distinct keys stored. **/
+  size_t unique = 0;
+  /** Bytes of key text stored once each. **/
+  size_t bytesStored = 0;
+  /** Bytes of key text passed to either, duplicates included: what
+   * storing every key separately would have cost. **/
+  size_t bytesRequested = 0;
+};
+
+/**
+ * @brief An intern table for object keys.
+ *
+ * Every distinct key is copied once into the pool's arena and handed out as
+ * an InternedKey; repeated keys resolve to the same bytes. Keys stay valid
+ * until the pool is destroyed.
+ *
+ * A Document interns its keys in a pool of its own unless it is given one to
+ * share. A pool shared between threads must be constructed with threadSafe
+ * set, which guards it with a reader/writer lock: lookups of keys already
+ * present only take the shared lock.
+ *
+ * Json::fromString(input, pool) interns the keys of the Json DOM through
+ * internJsonKey instead. Those keys are reference-counted rather than held in
+ * the arena, so they stay valid in the resulting Json after the pool is gone.
+ */
+class KeyPool {
+  // Lets jsonKeys be searched by string_view without building a JsonKey.
+  struct JsonKeyHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const noexcept {
+      return std::hash<std::string_view>()(key);
+    }
+    size_t operator()(const JsonKey& key) const noexcept { return key.hash(); }
+  };
+
+public:
+  explicit KeyPool(bool threadSafe = false) : threadSafe(threadSafe) {}
+
+  KeyPool(const KeyPool&) = delete;
+  KeyPool& operator=(const KeyPool&) = delete;
+
+  /** The canonical copy of key, adding it on first use. **/
+  InternedKey intern(std::string_view key);
+  /** The canonical copy of key if it has been interned, without adding it. **/
+  std::optional<InternedKey> find(std::string_view key) const;
+
+  /** The canonical JsonKey for key, adding it on first use. Every copy
+   * shares one buffer, even for keys short enough to be stored inline. **/
+  JsonKey internJsonKey(std::string_view key);
+
+  KeyPoolStats stats() const;
+
+private:
+  bool threadSafe;
+  mutable std::shared_mutex mutex;
+  Arena arena;
+  std::unordered_set<std::string_view> keys;
+  std::unordered_set<JsonKey, JsonKeyHash, std::equal_to<>> jsonKeys;
+  size_t bytesStored = 0;
+  std::atomic<size_t> lookups = 0;
+  std::atomic<size_t> bytesRequested = 0;
+};
+}  // namespace jerry
+
+template <> struct std::hash<jerry::InternedKey> {
+  size_t operator()(const jerry::InternedKey& key) const noexcept {
+    return std::hash<const char*>()(key.data());
+  }
+};
@@ -0,0 +1,125 @@
+#include "Lines.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "Reader.h"
+#include "ThreadPool.h"
+
+namespace jerry {
+namespace {
+struct ParsedChunk {
+  size_t index;
+  std::vector<LineRecord> records;
+};
+
+bool isBlank(std::string_view line) {
+  for (char c : line) {
+    if (!detail::isJsonWhitespace(c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<LineRecord> parseChunk(std::string_view input, size_t begin,
+                                   size_t end) {
+  std::vector<LineRecord> records;
+  size_t pos = begin;
+  while (pos < end) {
+    size_t newline = input.find('\n', pos);
+    size_t lineEnd = newline < end ? newline : end;
+    std::string_view line = input.substr(pos, lineEnd - pos);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (!isBlank(line)) {
+      std::optional<JsonValue> value;
+      if (auto json = Json::fromString(line)) {
+        value = std::move(*json).getValue();
+      }
+      records.push_back({pos, line, std::move(value)});
+    }
+    pos = lineEnd + 1;
+  }
+  return records;
+}
+
+// End of the chunk starting at begin: chunkBytes on, then to the next
+// newline.
+size_t chunkEnd(std::string_view input, size_t begin, size_t chunkBytes) {
+  if (input.size() - begin <= chunkBytes) {
+    return input.size();
+  }
+  size_t newline = input.find('\n', begin + chunkBytes);
+  return newline == std::string_view::npos ? input.size() : newline + 1;
+}
+}  // namespace
+
+ParseLinesResult parseLines(std::string_view input,
+                            const std::function<bool(LineRecord&)>& onRecord,
+                            const ParseLinesOptions& options) {
+  std::optional<ThreadPool> ownedPool;
+  ThreadPool* pool = options.pool;
+  if (!pool) {
+    pool = &ownedPool.emplace(options.threads);
+  }
+  size_t maxInFlight = options.maxChunksInFlight
+                           ? options.maxChunksInFlight
+                           : 2 * pool->size();
+  size_t chunkBytes = std::max<size_t>(options.chunkBytes, 1);
+
+  // At most maxInFlight chunks are ever submitted but not yet delivered, so
+  // pushes into the queue never block and a chunk waiting in `reorder` can
+  // never hold up the one it is waiting for.
+  BoundedQueue<ParsedChunk> finished(maxInFlight);
+  std::map<size_t, std::vector<LineRecord>> reorder;
+  ParseLinesResult result;
+  size_t begin = 0;
+  size_t submitted = 0;
+  size_t delivered = 0;
+
+  auto submitMore = [&] {
+    while (!result.stopped && begin < input.size() &&
+           submitted - delivered < maxInFlight) {
+      size_t end = chunkEnd(input, begin, chunkBytes);
+      pool->submit([&finished, input, begin, end, index = submitted] {
+        finished.push({index, parseChunk(input, begin, end)});
+      });
+      begin = end;
+      submitted++;
+    }
+  };
+
+  auto deliver = [&](std::vector<LineRecord>& records) {
+    for (auto& record : records) {
+      if (result.stopped) {
+        break;
+      }
+      result.records++;
+      result.errors += record.value ? 0 : 1;
+      result.stopped = !onRecord(record);
+    }
+    delivered++;
+  };
+
+  submitMore();
+  while (delivered < submitted) {
+    ParsedChunk chunk = *finished.pop();
+    if (!options.ordered) {
+      deliver(chunk.records);
+    } else {
+      reorder.emplace(chunk.index, std::move(chunk.records));
+      for (auto next = reorder.find(delivered); next != reorder.end();
+           next = reorder.find(delivered)) {
+        deliver(next->second);
+        reorder.erase(next);
+      }
+    }
+    submitMore();
+  }
+  return result;
+}
+}  // namespace jerry
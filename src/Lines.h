@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+
+#include "Json.h"
+
+namespace jerry {
+class ThreadPool;
+
+/** One non-blank line of a JSON Lines input. **/
+struct LineRecord {
+  /** Byte offset of the line in the input. **/
+  size_t offset;
+  /** The line without its terminating newline. **/
+  std::string_view text;
+  /** The parsed value, or nullopt if the line is not valid JSON. **/
+  std::optional<JsonValue> value;
+};
+
+struct ParseLinesOptions {
+  /** Worker threads to start when no pool is given; 0 means one per core. **/
+  size_t threads = 0;
+  /** Run on this pool instead of starting threads. **/
+  ThreadPool* pool = nullptr;
+  /** Target chunk size. Chunks are extended to the next newline so that no
+   * record is split. **/
+  size_t chunkBytes = 1 << 20;
+  /** Deliver records in input order. When false, each chunk's records are
+   * delivered as soon as the chunk is parsed. **/
+  bool ordered = true;
+  /** Parsed chunks allowed to wait for delivery; 0 means twice the thread
+   * count. Bounds memory when the consumer is slower than the parsers. **/
+  size_t maxChunksInFlight = 0;
+};
+
+struct ParseLinesResult {
+  /** Records delivered to the callback. **/
+  size_t records = 0;
+  /** Delivered records whose value is nullopt. **/
+  size_t errors = 0;
+  /** True if the callback returned false. **/
+  bool stopped = false;
+};
+
+/**
+ * @brief Parses newline-delimited JSON in parallel.
+ *
+ * The input is cut into record-aligned chunks that are parsed on a
+ * work-stealing ThreadPool. Parsed chunks come back through a bounded queue
+ * and onRecord is called on the calling thread, one record at a time.
+ * Blank lines are skipped and a trailing "\r" is ignored. onRecord returns
+ * false to stop; chunks already being parsed are finished and discarded.
+ *
+ * The input must outlive the call; LineRecord::text views it.
+ */
+ParseLinesResult parseLines(std::string_view input,
+                            const std::function<bool(LineRecord&)>& onRecord,
+                            const ParseLinesOptions& options = {});
+}  // namespace jerry
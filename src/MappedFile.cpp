@@ -0,0 +1,90 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JERRY_HAVE_MMAP 1
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace jerry {
+std::optional<MappedFile> MappedFile::open(const std::string& path) {
+  MappedFile file;
+#ifdef JERRY_HAVE_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  file.length = static_cast<size_t>(info.st_size);
+  if (file.length == 0) {
+    // mmap rejects empty mappings; an empty view needs none.
+    ::close(fd);
+    return file;
+  }
+  void* mapping = mmap(nullptr, file.length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    return std::nullopt;
+  }
+  // Hints only: failures are harmless.
+  madvise(mapping, file.length, MADV_SEQUENTIAL);
+  madvise(mapping, file.length, MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+  madvise(mapping, file.length, MADV_HUGEPAGE);
+#endif
+  file.data = static_cast<const char*>(mapping);
+#else
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  file.fallback.assign(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  file.data = file.fallback.data();
+  file.length = file.fallback.size();
+#endif
+  return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    release();
+    bool ownsFallback = other.data && other.data == other.fallback.data();
+    fallback = std::move(other.fallback);
+    data = ownsFallback ? fallback.data() : other.data;
+    length = other.length;
+    other.data = nullptr;
+    other.length = 0;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { release(); }
+
+void MappedFile::release() noexcept {
+#ifdef JERRY_HAVE_MMAP
+  if (data && fallback.empty()) {
+    munmap(const_cast<char*>(data), length);
+  }
+#endif
+  data = nullptr;
+  length = 0;
+  fallback.clear();
+}
+}  // namespace jerry
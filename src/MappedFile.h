@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace jerry {
+/**
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * Parsing from the mapping avoids copying the file into a std::string: pages
+ * are faulted in from the page cache as the parser reaches them. The kernel
+ * is told the mapping will be read sequentially, and transparent huge pages
+ * are requested where supported. Move-only; the mapping is released when the
+ * MappedFile is destroyed.
+ *
+ * On platforms without mmap the file is read into memory instead.
+ */
+class MappedFile {
+public:
+  /** nullopt if the file cannot be opened or mapped. **/
+  static std::optional<MappedFile> open(const std::string& path);
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  std::string_view view() const noexcept { return {data, length}; }
+  size_t size() const noexcept { return length; }
+
+private:
+  MappedFile() = default;
+
+  const char* data = nullptr;
+  size_t length = 0;
+  // Set when the contents were read rather than mapped.
+  std::string fallback;
+
+  void release() noexcept;
+};
+}  // namespace jerry
@@ -0,0 +1,137 @@
+#include "NumberParser.h"
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace jerry {
+namespace {
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// True if all eight bytes of a little-endian load are ASCII digits.
+bool allEightDigits(uint64_t chunk) {
+  return (((chunk & 0xF0F0F0F0F0F0F0F0) |
+           (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+          0x3333333333333333);
+}
+
+// Converts eight ASCII digits (little-endian load) to their value with three
+// multiplies instead of eight.
+uint32_t parseEightDigits(uint64_t chunk) {
+  const uint64_t mask = 0x000000FF000000FF;
+  const uint64_t mul1 = 0x000F424000000064;  // 100 + (1000000ULL << 32)
+  const uint64_t mul2 = 0x0000271000000001;  // 1 + (10000ULL << 32)
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+  return static_cast<uint32_t>(chunk);
+}
+
+// Consumes a run of digits starting at pos, accumulating into value. Returns
+// the number of digits consumed; value is only meaningful while that count is
+// at most 19.
+size_t consumeDigits(std::string_view input, size_t& pos, uint64_t& value) {
+  size_t start = pos;
+  if constexpr (std::endian::native == std::endian::little) {
+    while (pos + 8 <= input.size()) {
+      uint64_t chunk;
+      std::memcpy(&chunk, input.data() + pos, sizeof(chunk));
+      if (!allEightDigits(chunk)) {
+        break;
+      }
+      value = value * 100000000 + parseEightDigits(chunk);
+      pos += 8;
+    }
+  }
+  while (pos < input.size() && isDigit(input[pos])) {
+    value = value * 10 + static_cast<uint64_t>(input[pos] - '0');
+    pos++;
+  }
+  return pos - start;
+}
+
+std::optional<double> toDouble(std::string_view literal) {
+  double value = 0;
+  auto [ptr, ec] =
+      std::from_chars(literal.data(), literal.data() + literal.size(), value);
+  if (ec == std::errc()) {
+    return value;
+  }
+  if (ec != std::errc::result_out_of_range) {
+    return std::nullopt;
+  }
+  // from_chars does not say whether it overflowed or underflowed. This path
+  // is only taken for extreme exponents, so let strtod tell us.
+  std::string copy(literal);
+  value = std::strtod(copy.c_str(), nullptr);
+  if (std::isinf(value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+}  // namespace
+
+std::optional<ParsedNumber> parseNumber(std::string_view input, size_t pos) {
+  size_t start = pos;
+  bool isNegative = false;
+  if (pos < input.size() && input[pos] == '-') {
+    isNegative = true;
+    pos++;
+  }
+  if (pos >= input.size() || !isDigit(input[pos])) {
+    return std::nullopt;
+  }
+
+  uint64_t mantissa = 0;
+  size_t integerDigits;
+  if (input[pos] == '0') {
+    // No leading zeros: "0" is the whole integer part.
+    pos++;
+    integerDigits = 1;
+  } else {
+    integerDigits = consumeDigits(input, pos, mantissa);
+  }
+
+  bool isInteger = true;
+  if (pos < input.size() && input[pos] == '.') {
+    pos++;
+    uint64_t ignored = 0;
+    if (consumeDigits(input, pos, ignored) == 0) {
+      return std::nullopt;
+    }
+    isInteger = false;
+  }
+  if (pos < input.size() && (input[pos] == 'e' || input[pos] == 'E')) {
+    pos++;
+    if (pos < input.size() && (input[pos] == '+' || input[pos] == '-')) {
+      pos++;
+    }
+    uint64_t ignored = 0;
+    if (consumeDigits(input, pos, ignored) == 0) {
+      return std::nullopt;
+    }
+    isInteger = false;
+  }
+
+  // 19 digits always fit in a uint64_t; -0 needs a double to keep its sign.
+  if (isInteger && integerDigits <= 19 && !(isNegative && mantissa == 0)) {
+    constexpr uint64_t maxPositive = std::numeric_limits<int64_t>::max();
+    if (!isNegative && mantissa <= maxPositive) {
+      return ParsedNumber{static_cast<int64_t>(mantissa), pos};
+    }
+    if (isNegative && mantissa <= maxPositive + 1) {
+      return ParsedNumber{static_cast<int64_t>(0 - mantissa), pos};
+    }
+  }
+
+  auto value = toDouble(input.substr(start, pos - start));
+  if (!value) {
+    return std::nullopt;
+  }
+  return ParsedNumber{*value, pos};
+}
+}  // namespace jerry
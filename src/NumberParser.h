@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+namespace jerry {
+struct ParsedNumber {
+  // int64_t when the literal is an integer (no fraction or exponent, not -0)
+  // that fits in 64 bits, double otherwise.
+  std::variant<int64_t, double> value;
+  // Offset just past the last byte of the literal.
+  size_t end;
+};
+
+/**
+ * @brief Parses an RFC 8259 number literal starting at pos.
+ *
+ * Grammar: `-? (0 | [1-9][0-9]*) (\.[0-9]+)? ([eE][+-]?[0-9]+)?`. Parsing stops
+ * at the first byte that cannot continue the literal; the caller decides
+ * whether that byte is a valid delimiter.
+ *
+ * Integer digits are consumed eight at a time. Integers that fit in int64_t
+ * are returned exactly; everything else is converted with std::from_chars,
+ * which is correctly rounded.
+ *
+ * @return nullopt if no valid number starts at pos, or if its magnitude
+ * overflows a double.
+ */
+std::optional<ParsedNumber> parseNumber(std::string_view input, size_t pos);
+}  // namespace jerry
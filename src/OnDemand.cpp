@@ -0,0 +1,282 @@
+#include "OnDemand.h"
+
+#include "Reader.h"
+#include "Skip.h"
+#include "StringDecoder.h"
+#include "Tokenizer.h"
+#include "Utf8.h"
+
+namespace jerry::ondemand {
+namespace {
+// A scalar must be followed by whitespace, a separator or the end of input;
+// otherwise "12abc" would read as 12.
+bool atValueEnd(std::string_view input, size_t pos) {
+  if (pos >= input.size()) {
+    return true;
+  }
+  char c = input[pos];
+  return detail::isJsonWhitespace(c) || c == ',' || c == ']' || c == '}';
+}
+
+template <typename T>
+std::optional<JsonToken> readScalar(std::string_view input, size_t pos,
+                                    const T& tokenizer) {
+  if (pos >= input.size()) {
+    return std::nullopt;
+  }
+  auto result = tokenizer.run(TokenizerState(input, pos));
+  if (!result || !atValueEnd(input, result->second.getPosition())) {
+    return std::nullopt;
+  }
+  return std::move(result->first);
+}
+
+bool keyEquals(const Value::Field& field, std::string_view key) {
+  return field.escaped ? field.key() == key : field.rawKey == key;
+}
+}  // namespace
+
+std::optional<bool> Value::getBool() const {
+  if (!isBool()) {
+    return std::nullopt;
+  }
+  auto token = readScalar(input, pos, boolean());
+  if (!token) {
+    return std::nullopt;
+  }
+  return std::get<bool>(token->value);
+}
+
+std::optional<int64_t> Value::getInt64() const {
+  if (!isNumber()) {
+    return std::nullopt;
+  }
+  auto token = readScalar(input, pos, jsonNumber());
+  return token ? token->toInteger() : std::nullopt;
+}
+
+std::optional<double> Value::getDouble() const {
+  if (!isNumber()) {
+    return std::nullopt;
+  }
+  auto token = readScalar(input, pos, jsonNumber());
+  return token ? token->toNumber() : std::nullopt;
+}
+
+std::optional<std::string> Value::getString() const {
+  if (!isString()) {
+    return std::nullopt;
+  }
+  auto token = readScalar(input, pos, jsonString());
+  return token ? token->toString() : std::nullopt;
+}
+
+std::optional<std::string_view> Value::getRawString() const {
+  if (!isString()) {
+    return std::nullopt;
+  }
+  auto end = skipString(input, pos + 1);
+  if (!end) {
+    return std::nullopt;
+  }
+  auto body = input.substr(pos + 1, *end - pos - 2);
+  if (!utf8::isValid(body)) {
+    return std::nullopt;
+  }
+  return body;
+}
+
+std::optional<std::string_view> Value::getRawJson() const {
+  auto last = end();
+  if (!last) {
+    return std::nullopt;
+  }
+  return input.substr(pos, *last - pos);
+}
+
+std::optional<JsonValue> Value::toJsonValue() const {
+  auto raw = getRawJson();
+  if (!raw) {
+    return std::nullopt;
+  }
+  auto json = Json::fromString(*raw);
+  if (!json) {
+    return std::nullopt;
+  }
+  return std::move(*json).getValue();
+}
+
+std::optional<size_t> Value::end() const {
+  if (!valid()) {
+    return std::nullopt;
+  }
+  return skipValue(input, pos);
+}
+
+Value Value::scanFields(std::string_view key, size_t from, size_t until) const {
+  for (FieldIterator it(input, from); it != FieldIterator();) {
+    if (it.pos == until) {
+      break;
+    }
+    bool match = keyEquals(*it, key);
+    Value value = it->value;
+    ++it;
+    if (match) {
+      cursor = it.pos == kInvalid ? input.size() : it.pos;
+      return value;
+    }
+  }
+  cursor = until == kInvalid ? input.size() : until;
+  return Value();
+}
+
+Value Value::findField(std::string_view key) const {
+  if (!isObject()) {
+    return Value();
+  }
+  size_t from = cursor == kInvalid ? skipWhitespace(input, pos + 1) : cursor;
+  return scanFields(key, from, kInvalid);
+}
+
+Value Value::operator[](std::string_view key) const {
+  if (!isObject()) {
+    return Value();
+  }
+  size_t start = skipWhitespace(input, pos + 1);
+  size_t from = cursor == kInvalid ? start : cursor;
+  Value found = scanFields(key, from, kInvalid);
+  if (found || from == start) {
+    return found;
+  }
+  return scanFields(key, start, from);
+}
+
+Value Value::operator[](size_t i) const {
+  if (!isArray()) {
+    return Value();
+  }
+  for (Value element : elements()) {
+    if (i-- == 0) {
+      return element;
+    }
+  }
+  return Value();
+}
+
+Value::Range<Value::ElementIterator> Value::elements() const {
+  if (!isArray()) {
+    return {};
+  }
+  size_t first = skipWhitespace(input, pos + 1);
+  if (first >= input.size() || input[first] == ']') {
+    return {};
+  }
+  return {ElementIterator(input, first)};
+}
+
+Value::Range<Value::FieldIterator> Value::fields() const {
+  if (!isObject()) {
+    return {};
+  }
+  return {FieldIterator(input, skipWhitespace(input, pos + 1))};
+}
+
+std::optional<std::string> Value::Field::key() const {
+  if (!escaped) {
+    return std::string(rawKey);
+  }
+  // rawKey is followed by its closing quote in the input.
+  std::string decoded;
+  if (!decodeString(std::string_view(rawKey.data(), rawKey.size() + 1), 0,
+                    decoded)) {
+    return std::nullopt;
+  }
+  return decoded;
+}
+
+Value::ElementIterator& Value::ElementIterator::operator++() {
+  auto end = skipValue(input, pos);
+  size_t next = end ? skipWhitespace(input, *end) : input.size();
+  if (next < input.size() && input[next] == ',') {
+    pos = skipWhitespace(input, next + 1);
+    if (pos >= input.size() || input[pos] == ']') {
+      pos = kInvalid;
+    }
+  } else {
+    pos = kInvalid;
+  }
+  return *this;
+}
+
+Value::FieldIterator::FieldIterator(std::string_view input, size_t pos)
+    : input(input), pos(pos) {
+  load();
+}
+
+void Value::FieldIterator::load() {
+  if (pos >= input.size() || input[pos] != '"') {
+    pos = kInvalid;
+    return;
+  }
+  auto keyEnd = skipString(input, pos + 1);
+  if (!keyEnd) {
+    pos = kInvalid;
+    return;
+  }
+  size_t colon = skipWhitespace(input, *keyEnd);
+  if (colon >= input.size() || input[colon] != ':') {
+    pos = kInvalid;
+    return;
+  }
+  field.rawKey = input.substr(pos + 1, *keyEnd - pos - 2);
+  field.escaped = field.rawKey.find('\\') != std::string_view::npos;
+  field.value = Value(input, skipWhitespace(input, colon + 1));
+}
+
+Value::FieldIterator& Value::FieldIterator::operator++() {
+  auto end = field.value.end();
+  size_t next = end ? skipWhitespace(input, *end) : input.size();
+  if (next < input.size() && input[next] == ',') {
+    pos = skipWhitespace(input, next + 1);
+    load();
+  } else {
+    pos = kInvalid;
+  }
+  return *this;
+}
+
+std::optional<Document> Document::fromString(std::string_view input) {
+  size_t pos = skipWhitespace(input, 0);
+  if (pos >= input.size()) {
+    return std::nullopt;
+  }
+  switch (input[pos]) {
+    case '{':
+    case '[':
+    case '"':
+    case '-':
+    case 't':
+    case 'f':
+    case 'n':
+      break;
+    default:
+      if (input[pos] < '0' || input[pos] > '9') {
+        return std::nullopt;
+      }
+  }
+  return Document(Value(input, pos));
+}
+
+std::optional<Document> Document::fromFile(const std::string& path) {
+  auto file = MappedFile::open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  auto mapping = std::make_shared<const MappedFile>(std::move(*file));
+  auto doc = fromString(mapping->view());
+  if (doc) {
+    doc->file = std::move(mapping);
+  }
+  return doc;
+}
+}  // namespace jerry::ondemand
@@ -0,0 +1,209 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Json.h"
+#include "MappedFile.h"
+
+namespace jerry::ondemand {
+/**
+ * @brief A lazily parsed JSON value: a position in the input, nothing more.
+ *
+ * Nothing is decoded until a getter is called, and values that are never
+ * read are skipped by counting brackets rather than parsed. A Value does not
+ * own the input, which must outlive it.
+ *
+ * Field lookups on an object are forward-only: each lookup starts where the
+ * previous one on the same Value stopped. Looking up fields in document order
+ * therefore reads every byte of the object at most once. A key that is not
+ * found ahead of the cursor is searched for again from the start of the
+ * object, which costs a second pass. See README.md for the full rules.
+ *
+ * Skipped values are not validated; malformed input is only reported when
+ * the malformed part is read.
+ */
+class Value {
+public:
+  Value() : pos(kInvalid), cursor(kInvalid) {}
+  Value(std::string_view input, size_t pos)
+      : input(input), pos(pos), cursor(kInvalid) {}
+
+  /** False for the Value returned by a failed lookup. **/
+  bool valid() const noexcept { return pos < input.size(); }
+  explicit operator bool() const noexcept { return valid(); }
+
+  /** Type checks look at the first byte only. **/
+  bool isNull() const noexcept { return startsWith('n'); }
+  bool isBool() const noexcept { return startsWith('t') || startsWith('f'); }
+  bool isNumber() const noexcept {
+    return valid() &&
+           (input[pos] == '-' || (input[pos] >= '0' && input[pos] <= '9'));
+  }
+  bool isString() const noexcept { return startsWith('"'); }
+  bool isArray() const noexcept { return startsWith('['); }
+  bool isObject() const noexcept { return startsWith('{'); }
+
+  std::optional<bool> getBool() const;
+  /** The value of an integer that fits in int64_t. **/
+  std::optional<int64_t> getInt64() const;
+  /** The value of any number, converted to double if needed. **/
+  std::optional<double> getDouble() const;
+  /** The decoded string. **/
+  std::optional<std::string> getString() const;
+  /** The string body exactly as it appears in the input, without decoding.
+   * Equal to getString() when the string has no escapes. **/
+  std::optional<std::string_view> getRawString() const;
+  /** The whole value's source text. **/
+  std::optional<std::string_view> getRawJson() const;
+
+  /** Fully parses this value into the JsonValue representation. **/
+  std::optional<JsonValue> toJsonValue() const;
+
+  /**
+   * @brief The member named key, searching only ahead of the cursor.
+   *
+   * Moves the cursor past the member on success and to the end of the
+   * object on failure, so later lookups only see members after it.
+   */
+  Value findField(std::string_view key) const;
+  /** Like findField, but wraps around to the start of the object when the
+   * key is not found ahead of the cursor. **/
+  Value operator[](std::string_view key) const;
+  /** The i-th array element; invalid if out of range or not an array. **/
+  Value operator[](size_t i) const;
+
+  class ElementIterator;
+  class FieldIterator;
+  struct Field;
+
+  template <typename Iterator> struct Range {
+    Iterator first;
+    Iterator begin() const { return first; }
+    Iterator end() const { return Iterator(); }
+  };
+
+  /** Single-pass iteration over an array's elements. **/
+  Range<ElementIterator> elements() const;
+  /** Single-pass iteration over an object's members, in document order. **/
+  Range<FieldIterator> fields() const;
+
+private:
+  static constexpr size_t kInvalid = static_cast<size_t>(-1);
+
+  std::string_view input;
+  size_t pos;
+  // Offset of the next unvisited member of an object, input.size() once all
+  // members have been visited, or kInvalid before the first lookup. Only a
+  // search hint, so lookups stay const.
+  mutable size_t cursor;
+
+  bool startsWith(char c) const noexcept { return valid() && input[pos] == c; }
+
+  // Offset just past the value, without validating its contents.
+  std::optional<size_t> end() const;
+  // Searches members from `from` until `until` (an offset, or the end of the
+  // object when kInvalid).
+  Value scanFields(std::string_view key, size_t from, size_t until) const;
+};
+
+/** One object member: its key as it appears in the input, and its value. **/
+struct Value::Field {
+  std::string_view rawKey;
+  bool escaped;
+  Value value;
+
+  /** The decoded key, or nullopt if its escapes are malformed. Equal to
+   * rawKey when escaped is false. **/
+  std::optional<std::string> key() const;
+};
+
+/**
+ * @brief Input iterator over an array's elements.
+ *
+ * Iteration stops at the closing bracket, or early if the array is malformed.
+ */
+class Value::ElementIterator {
+public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = Value;
+  using difference_type = std::ptrdiff_t;
+
+  ElementIterator() : pos(kInvalid) {}
+  ElementIterator(std::string_view input, size_t pos)
+      : input(input), pos(pos) {}
+
+  Value operator*() const { return Value(input, pos); }
+  ElementIterator& operator++();
+  bool operator==(const ElementIterator& other) const {
+    return pos == other.pos;
+  }
+
+private:
+  std::string_view input;
+  size_t pos;
+};
+
+/**
+ * @brief Input iterator over an object's members.
+ *
+ * Iteration stops at the closing brace, or early if the object is malformed.
+ */
+class Value::FieldIterator {
+public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = Field;
+  using difference_type = std::ptrdiff_t;
+
+  FieldIterator() : pos(kInvalid) {}
+  // pos is the offset of a member's opening key quote.
+  FieldIterator(std::string_view input, size_t pos);
+
+  const Field& operator*() const { return field; }
+  const Field* operator->() const { return &field; }
+  FieldIterator& operator++();
+  bool operator==(const FieldIterator& other) const {
+    return pos == other.pos;
+  }
+
+private:
+  std::string_view input;
+  size_t pos;
+  Field field{};
+
+  void load();
+
+  friend class Value;
+};
+
+/**
+ * @brief An on-demand view of a JSON document.
+ *
+ * Construction only checks that the input starts with a value; everything
+ * else is read when it is accessed. Lookups through the Document share the
+ * root Value's cursor, so `doc["a"]` followed by `doc["b"]` continues from
+ * where the first lookup stopped.
+ */
+class Document {
+public:
+  static std::optional<Document> fromString(std::string_view input);
+  /** Views a memory-mapped file, which stays mapped while the Document or
+   * any copy of it is alive. Values must not outlive the Document. **/
+  static std::optional<Document> fromFile(const std::string& path);
+
+  const Value& root() const noexcept { return rootValue; }
+
+  Value operator[](std::string_view key) const { return rootValue[key]; }
+  Value operator[](size_t i) const { return rootValue[i]; }
+
+private:
+  explicit Document(Value root) : rootValue(root) {}
+
+  Value rootValue;
+  std::shared_ptr<const MappedFile> file;
+};
+}  // namespace jerry::ondemand
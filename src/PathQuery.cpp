@@ -0,0 +1,327 @@
+#include "PathQuery.h"
+
+#include <algorithm>
+
+#include "Skip.h"
+#include "StringDecoder.h"
+#include "Utf8.h"
+
+namespace jerry::ondemand {
+namespace {
+// Decodes one pointer segment (~0 is '~', ~1 is '/').
+std::optional<std::string> unescapeSegment(std::string_view segment) {
+  std::string out;
+  out.reserve(segment.size());
+  for (size_t i = 0; i < segment.size(); i++) {
+    if (segment[i] != '~') {
+      out += segment[i];
+      continue;
+    }
+    if (i + 1 == segment.size() ||
+        (segment[i + 1] != '0' && segment[i + 1] != '1')) {
+      return std::nullopt;
+    }
+    out += segment[++i] == '0' ? '~' : '/';
+  }
+  return out;
+}
+
+// The array index a segment names: digits without a leading zero.
+std::optional<size_t> segmentIndex(std::string_view segment) {
+  if (segment.empty() || segment.size() > 18 ||
+      (segment.size() > 1 && segment[0] == '0')) {
+    return std::nullopt;
+  }
+  size_t index = 0;
+  for (char c : segment) {
+    if (c < '0' || c > '9') {
+      return std::nullopt;
+    }
+    index = index * 10 + static_cast<size_t>(c - '0');
+  }
+  return index;
+}
+}  // namespace
+
+std::optional<PathQuery> PathQuery::compile(
+    const std::vector<std::string>& paths) {
+  PathQuery query;
+  query.nodes.emplace_back();
+  query.pathCount = paths.size();
+  for (size_t p = 0; p < paths.size(); p++) {
+    std::string_view rest = paths[p];
+    if (!rest.empty() && rest[0] != '/') {
+      return std::nullopt;
+    }
+    uint32_t node = 0;
+    while (!rest.empty()) {
+      rest.remove_prefix(1);
+      size_t slash = rest.find('/');
+      std::string_view raw = rest.substr(0, slash);
+      rest = slash == std::string_view::npos ? std::string_view()
+                                             : rest.substr(slash);
+      auto next = static_cast<uint32_t>(query.nodes.size());
+      if (raw == "*") {
+        if (query.nodes[node].wildcard == kNone) {
+          query.nodes[node].wildcard = next;
+          query.nodes.emplace_back();
+        }
+        node = query.nodes[node].wildcard;
+        continue;
+      }
+      auto segment = unescapeSegment(raw);
+      if (!segment) {
+        return std::nullopt;
+      }
+      auto& keys = query.nodes[node].keys;
+      auto it = std::find_if(keys.begin(), keys.end(), [&](const auto& k) {
+        return k.first == *segment;
+      });
+      if (it != keys.end()) {
+        node = it->second;
+        continue;
+      }
+      keys.emplace_back(*segment, next);
+      if (auto index = segmentIndex(*segment)) {
+        query.nodes[node].indices.emplace_back(*index, next);
+      }
+      query.nodes.emplace_back();
+      node = next;
+    }
+    query.nodes[node].paths.push_back(p);
+  }
+  for (auto& node : query.nodes) {
+    std::sort(node.keys.begin(), node.keys.end());
+    std::sort(node.indices.begin(), node.indices.end());
+  }
+  return query;
+}
+
+/**
+ * The state of one run(): a position in the input and, per depth, the set
+ * of trie nodes the value being read there is reached by. The sets are
+ * reused from member to member, so a scan allocates only while it first
+ * grows them.
+ */
+class PathQuery::Scan {
+public:
+  Scan(const PathQuery& query, std::string_view input, const OnMatch& onMatch)
+      : query(query), input(input), onMatch(onMatch) {}
+
+  bool run() {
+    levels.assign(1, {0});
+    pos = skipWhitespace(input, 0);
+    if (pos >= input.size() || !value(0)) {
+      return false;
+    }
+    return stopped || skipWhitespace(input, pos) == input.size();
+  }
+
+private:
+  const PathQuery& query;
+  std::string_view input;
+  const OnMatch& onMatch;
+  size_t pos = 0;
+  bool stopped = false;
+  std::vector<std::vector<uint32_t>> levels;
+  std::string scratch;
+
+  // Reads the value at pos, reached through the nodes in levels[depth], and
+  // leaves pos just past it.
+  bool value(size_t depth) {
+    bool descend = false;
+    for (uint32_t n : levels[depth]) {
+      const Node& node = query.nodes[n];
+      for (size_t path : node.paths) {
+        if (!onMatch(path, Value(input, pos))) {
+          stopped = true;
+          return true;
+        }
+      }
+      descend = descend || node.hasChildren();
+    }
+    if (descend && pos < input.size()) {
+      if (input[pos] == '{') {
+        return object(depth);
+      }
+      if (input[pos] == '[') {
+        return array(depth);
+      }
+    }
+    return skip();
+  }
+
+  bool skip() {
+    auto end = skipValue(input, pos);
+    if (!end) {
+      return false;
+    }
+    pos = *end;
+    return true;
+  }
+
+  // The set for the next depth, emptied.
+  std::vector<uint32_t>& childLevel(size_t depth) {
+    if (levels.size() <= depth + 1) {
+      levels.resize(depth + 2);
+    }
+    levels[depth + 1].clear();
+    return levels[depth + 1];
+  }
+
+  // Reads the member or element at pos, descending only if some node
+  // continues through it.
+  bool child(size_t depth) {
+    pos = skipWhitespace(input, pos);
+    if (levels[depth + 1].empty()) {
+      return skip();
+    }
+    return value(depth + 1);
+  }
+
+  // After a member or element: true for ',', false for close, nullopt for
+  // anything else.
+  std::optional<bool> separator(char close) {
+    pos = skipWhitespace(input, pos);
+    if (pos >= input.size()) {
+      return std::nullopt;
+    }
+    char c = input[pos++];
+    if (c == ',') {
+      return true;
+    }
+    if (c == close) {
+      return false;
+    }
+    return std::nullopt;
+  }
+
+  bool object(size_t depth) {
+    pos = skipWhitespace(input, pos + 1);
+    if (pos < input.size() && input[pos] == '}') {
+      pos++;
+      return true;
+    }
+    while (!stopped) {
+      std::string_view key;
+      if (!readKey(key)) {
+        return false;
+      }
+      auto& next = childLevel(depth);
+      for (uint32_t n : levels[depth]) {
+        const Node& node = query.nodes[n];
+        auto it = std::lower_bound(node.keys.begin(), node.keys.end(), key,
+                                   [](const auto& entry, std::string_view k) {
+                                     return entry.first < k;
+                                   });
+        if (it != node.keys.end() && it->first == key) {
+          next.push_back(it->second);
+        }
+        if (node.wildcard != kNone) {
+          next.push_back(node.wildcard);
+        }
+      }
+      if (!child(depth)) {
+        return false;
+      }
+      if (stopped) {
+        break;
+      }
+      auto more = separator('}');
+      if (!more) {
+        return false;
+      }
+      if (!*more) {
+        return true;
+      }
+    }
+    return true;
+  }
+
+  bool array(size_t depth) {
+    pos = skipWhitespace(input, pos + 1);
+    if (pos < input.size() && input[pos] == ']') {
+      pos++;
+      return true;
+    }
+    for (size_t i = 0; !stopped; i++) {
+      auto& next = childLevel(depth);
+      for (uint32_t n : levels[depth]) {
+        const Node& node = query.nodes[n];
+        auto it = std::lower_bound(node.indices.begin(), node.indices.end(),
+                                   i, [](const auto& entry, size_t index) {
+                                     return entry.first < index;
+                                   });
+        if (it != node.indices.end() && it->first == i) {
+          next.push_back(it->second);
+        }
+        if (node.wildcard != kNone) {
+          next.push_back(node.wildcard);
+        }
+      }
+      if (!child(depth)) {
+        return false;
+      }
+      if (stopped) {
+        break;
+      }
+      auto more = separator(']');
+      if (!more) {
+        return false;
+      }
+      if (!*more) {
+        return true;
+      }
+    }
+    return true;
+  }
+
+  // Reads a key and the ':' after it. The view is of the input unless the
+  // key has escapes, in which case it is decoded into scratch.
+  bool readKey(std::string_view& key) {
+    pos = skipWhitespace(input, pos);
+    if (pos >= input.size() || input[pos] != '"') {
+      return false;
+    }
+    size_t begin = pos + 1;
+    size_t special = findStringSpecial(input, begin);
+    if (special < input.size() && input[special] == '"') {
+      key = input.substr(begin, special - begin);
+      if (!utf8::isValid(key)) {
+        return false;
+      }
+      pos = special + 1;
+    } else {
+      auto end = decodeString(input, begin, scratch);
+      if (!end) {
+        return false;
+      }
+      key = scratch;
+      pos = *end;
+    }
+    pos = skipWhitespace(input, pos);
+    if (pos >= input.size() || input[pos] != ':') {
+      return false;
+    }
+    pos++;
+    return true;
+  }
+};
+
+bool PathQuery::run(std::string_view input, const OnMatch& onMatch) const {
+  return Scan(*this, input, onMatch).run();
+}
+
+std::optional<std::vector<std::vector<Value>>> PathQuery::select(
+    std::string_view input) const {
+  std::vector<std::vector<Value>> matches(pathCount);
+  bool ok = run(input, [&matches](size_t path, const Value& value) {
+    matches[path].push_back(value);
+    return true;
+  });
+  if (!ok) {
+    return std::nullopt;
+  }
+  return matches;
+}
+}  // namespace jerry::ondemand
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "OnDemand.h"
+
+namespace jerry::ondemand {
+/**
+ * @brief A set of JSON Pointers evaluated together in one forward scan.
+ *
+ * Paths are RFC 6901 pointers (`/user/id`, `/a~1b` for the key "a/b"). A
+ * segment of `*` matches every member of an object or element of an array,
+ * so the segments items, *, price select the price of every item. A numeric
+ * segment matches both an array index and an object key spelled the same
+ * way. The empty pointer matches the whole document.
+ *
+ * The paths are compiled into a trie. The scan reads only the keys and
+ * indices that lead toward some path; every other member or element is
+ * passed over with skipValue, which counts brackets and quotes without
+ * parsing, so the cost tracks the bytes of the input rather than its number
+ * of values. Matches are reported as ondemand::Values, so a caller decodes
+ * only what it uses.
+ *
+ * Skipped subtrees are not validated, as elsewhere in ondemand.
+ */
+class PathQuery {
+public:
+  /** Called for each match, in document order, with the index of the path
+   * in the list given to compile(). Returns false to stop the scan. **/
+  using OnMatch = std::function<bool(size_t path, const Value& value)>;
+
+  /** Compiles paths, or nullopt if one is not a valid pointer. **/
+  static std::optional<PathQuery> compile(
+      const std::vector<std::string>& paths);
+
+  size_t size() const noexcept { return pathCount; }
+
+  /**
+   * @brief Scans input once, reporting every match.
+   *
+   * @return false if the input is malformed along the scanned route, true
+   * otherwise, including when onMatch stopped the scan.
+   */
+  bool run(std::string_view input, const OnMatch& onMatch) const;
+
+  /** The matches of each path, in document order; nullopt if run() fails. **/
+  std::optional<std::vector<std::vector<Value>>> select(
+      std::string_view input) const;
+
+private:
+  static constexpr uint32_t kNone = 0;
+
+  struct Node {
+    // Sorted by key for binary search.
+    std::vector<std::pair<std::string, uint32_t>> keys;
+    std::vector<std::pair<size_t, uint32_t>> indices;
+    // The child for `*`, or kNone. The root is never a child.
+    uint32_t wildcard = kNone;
+    // Paths that end here.
+    std::vector<size_t> paths;
+
+    bool hasChildren() const {
+      return !keys.empty() || !indices.empty() || wildcard != kNone;
+    }
+  };
+
+  std::vector<Node> nodes;
+  size_t pathCount = 0;
+
+  class Scan;
+};
+}  // namespace jerry::ondemand
@@ -0,0 +1,257 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "NumberParser.h"
+#include "StringDecoder.h"
+#include "Utf8.h"
+
+namespace jerry {
+namespace detail {
+inline bool isJsonWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/**
+ * @brief Recursive-descent driver shared by the non-DOM builders.
+ *
+ * Walks one JSON value and reports what it finds to a Builder, which must
+ * provide:
+ *
+ *   bool beginArray();           bool endArray(size_t count);
+ *   bool beginObject();          bool endObject(size_t count);
+ *   bool key(std::string_view);  bool string(std::string_view);
+ *   bool number(const ParsedNumber&, std::string_view literal);
+ *   bool boolean(bool);          bool null();
+ *
+ * Every callback returns false to stop parsing. Strings are decoded into a
+ * scratch buffer owned by the Reader; the view passed to key()/string() is
+ * only valid for the duration of the call. The Builder is a template
+ * parameter, so every callback is statically dispatched.
+ *
+ * A Builder that wants string positions rather than decoded text can define
+ * instead:
+ *
+ *   bool rawKey(size_t begin, size_t end, bool escaped);
+ *   bool rawString(size_t begin, size_t end, bool escaped);
+ *
+ * where [begin, end) is the string body between the quotes and escaped says
+ * whether it contains any backslash escapes. Nothing is decoded then.
+ */
+template <typename Builder>
+concept RawStringBuilder = requires(Builder& b, size_t n, bool e) {
+  { b.rawString(n, n, e) } -> std::convertible_to<bool>;
+  { b.rawKey(n, n, e) } -> std::convertible_to<bool>;
+};
+
+template <typename Builder> class Reader {
+public:
+  static constexpr size_t kMaxDepth = 1024;
+
+  Reader(std::string_view input, Builder& builder)
+      : input(input), pos(0), builder(builder) {}
+
+  /** Parses a single value surrounded by optional whitespace and requires
+   * the input to end after it. **/
+  bool parseDocument() {
+    checkedUtf8 = utf8::findInvalid(input);
+    skipWhitespace();
+    if (!parseValue(0)) {
+      return false;
+    }
+    skipWhitespace();
+    return pos == input.size();
+  }
+
+  /** Parses one value starting at the current position (after optional
+   * whitespace) and leaves the position just past it. **/
+  bool parseNext() {
+    skipWhitespace();
+    return parseValue(0);
+  }
+
+  /** Offset of the next unread byte, or of the error after a failure. **/
+  size_t position() const { return pos; }
+
+  void skipWhitespace() {
+    while (pos < input.size() && isJsonWhitespace(input[pos])) {
+      pos++;
+    }
+  }
+
+private:
+  std::string_view input;
+  size_t pos;
+  Builder& builder;
+  std::string scratch;
+  // Strings ending at or before this offset are known to be well-formed
+  // UTF-8. parseDocument checks the whole input up front (see
+  // utf8::findInvalid); a bare parseValue checks each string.
+  size_t checkedUtf8 = 0;
+
+  char peek() const { return pos < input.size() ? input[pos] : '\0'; }
+
+  bool parseValue(size_t depth) {
+    switch (peek()) {
+      case '{':
+        return parseObject(depth);
+      case '[':
+        return parseArray(depth);
+      case '"':
+        if constexpr (RawStringBuilder<Builder>) {
+          size_t begin, end;
+          bool escaped;
+          return parseRawString(begin, end, escaped) &&
+                 builder.rawString(begin, end, escaped);
+        } else {
+          return parseString() && builder.string(scratch);
+        }
+      case 't':
+        return parseLiteral("true") && builder.boolean(true);
+      case 'f':
+        return parseLiteral("false") && builder.boolean(false);
+      case 'n':
+        return parseLiteral("null") && builder.null();
+      default:
+        return parseNumberValue();
+    }
+  }
+
+  bool parseArray(size_t depth) {
+    if (depth >= kMaxDepth || !builder.beginArray()) {
+      return false;
+    }
+    pos++;
+    skipWhitespace();
+    size_t count = 0;
+    if (peek() == ']') {
+      pos++;
+      return builder.endArray(count);
+    }
+    while (true) {
+      skipWhitespace();
+      if (!parseValue(depth + 1)) {
+        return false;
+      }
+      count++;
+      skipWhitespace();
+      char c = peek();
+      if (c == ']') {
+        pos++;
+        return builder.endArray(count);
+      }
+      if (c != ',') {
+        return false;
+      }
+      pos++;
+    }
+  }
+
+  bool parseObject(size_t depth) {
+    if (depth >= kMaxDepth || !builder.beginObject()) {
+      return false;
+    }
+    pos++;
+    skipWhitespace();
+    size_t count = 0;
+    if (peek() == '}') {
+      pos++;
+      return builder.endObject(count);
+    }
+    while (true) {
+      skipWhitespace();
+      if (peek() != '"' || !parseKey()) {
+        return false;
+      }
+      skipWhitespace();
+      if (peek() != ':') {
+        return false;
+      }
+      pos++;
+      skipWhitespace();
+      if (!parseValue(depth + 1)) {
+        return false;
+      }
+      count++;
+      skipWhitespace();
+      char c = peek();
+      if (c == '}') {
+        pos++;
+        return builder.endObject(count);
+      }
+      if (c != ',') {
+        return false;
+      }
+      pos++;
+    }
+  }
+
+  // Decodes the string at pos into scratch.
+  bool parseString() {
+    auto end = decodeString(input, pos + 1, scratch, checkedUtf8);
+    if (!end) {
+      return false;
+    }
+    pos = *end;
+    return true;
+  }
+
+  bool parseKey() {
+    if constexpr (RawStringBuilder<Builder>) {
+      size_t begin, end;
+      bool escaped;
+      return parseRawString(begin, end, escaped) &&
+             builder.rawKey(begin, end, escaped);
+    } else {
+      return parseString() && builder.key(scratch);
+    }
+  }
+
+  // Locates the string at pos without decoding it, checking that it is
+  // well-formed UTF-8.
+  bool parseRawString(size_t& begin, size_t& end, bool& escaped) {
+    begin = pos + 1;
+    size_t special = findStringSpecial(input, begin);
+    if (special >= input.size()) {
+      return false;
+    }
+    if (input[special] == '"') {
+      escaped = false;
+      end = special;
+    } else {
+      auto past = skipString(input, special);
+      if (!past) {
+        return false;
+      }
+      escaped = true;
+      end = *past - 1;
+    }
+    if (end > checkedUtf8 && !utf8::isValid(input.substr(begin, end - begin))) {
+      return false;
+    }
+    pos = end + 1;
+    return true;
+  }
+
+  bool parseLiteral(std::string_view word) {
+    if (input.substr(pos, word.size()) != word) {
+      return false;
+    }
+    pos += word.size();
+    return true;
+  }
+
+  bool parseNumberValue() {
+    auto number = parseNumber(input, pos);
+    if (!number) {
+      return false;
+    }
+    std::string_view literal = input.substr(pos, number->end - pos);
+    pos = number->end;
+    return builder.number(*number, literal);
+  }
+};
+}  // namespace detail
+}  // namespace jerry
@@ -0,0 +1,155 @@
+#include "Reflect.h"
+
+#include "NumberParser.h"
+#include "Skip.h"
+#include "StringDecoder.h"
+#include "Utf8.h"
+
+namespace jerry::detail {
+bool Cursor::open(char open) {
+  pos = skipWhitespace(input, pos);
+  if (pos >= input.size() || input[pos] != open || depth >= kMaxDepth) {
+    return false;
+  }
+  pos++;
+  depth++;
+  return true;
+}
+
+bool Cursor::close(char close) {
+  pos = skipWhitespace(input, pos);
+  if (pos >= input.size() || input[pos] != close) {
+    return false;
+  }
+  pos++;
+  depth--;
+  return true;
+}
+
+std::optional<bool> Cursor::separator(char close) {
+  pos = skipWhitespace(input, pos);
+  if (pos >= input.size()) {
+    return std::nullopt;
+  }
+  char c = input[pos++];
+  if (c == ',') {
+    return true;
+  }
+  if (c == close) {
+    depth--;
+    return false;
+  }
+  return std::nullopt;
+}
+
+bool Cursor::key(std::string_view& out) {
+  pos = skipWhitespace(input, pos);
+  if (pos >= input.size() || input[pos] != '"') {
+    return false;
+  }
+  size_t begin = pos + 1;
+  size_t special = findStringSpecial(input, begin);
+  if (special < input.size() && input[special] == '"') {
+    out = input.substr(begin, special - begin);
+    if (!utf8::isValid(out)) {
+      return false;
+    }
+    pos = special + 1;
+  } else {
+    auto end = decodeString(input, begin, scratch);
+    if (!end) {
+      return false;
+    }
+    out = scratch;
+    pos = *end;
+  }
+  pos = skipWhitespace(input, pos);
+  if (pos >= input.size() || input[pos] != ':') {
+    return false;
+  }
+  pos++;
+  return true;
+}
+
+bool Cursor::null() {
+  pos = skipWhitespace(input, pos);
+  if (input.substr(pos, 4) != "null") {
+    return false;
+  }
+  pos += 4;
+  return true;
+}
+
+bool Cursor::skip() {
+  pos = skipWhitespace(input, pos);
+  auto end = skipValue(input, pos);
+  if (!end) {
+    return false;
+  }
+  pos = *end;
+  return true;
+}
+
+bool Cursor::readBool(bool& out) {
+  pos = skipWhitespace(input, pos);
+  if (input.substr(pos, 4) == "true") {
+    out = true;
+    pos += 4;
+    return true;
+  }
+  if (input.substr(pos, 5) == "false") {
+    out = false;
+    pos += 5;
+    return true;
+  }
+  return false;
+}
+
+bool Cursor::readInt64(int64_t& out) {
+  pos = skipWhitespace(input, pos);
+  auto number = parseNumber(input, pos);
+  if (!number) {
+    return false;
+  }
+  auto* n = std::get_if<int64_t>(&number->value);
+  if (!n) {
+    return false;
+  }
+  out = *n;
+  pos = number->end;
+  return true;
+}
+
+bool Cursor::readDouble(double& out) {
+  pos = skipWhitespace(input, pos);
+  auto number = parseNumber(input, pos);
+  if (!number) {
+    return false;
+  }
+  if (auto* n = std::get_if<int64_t>(&number->value)) {
+    out = static_cast<double>(*n);
+  } else {
+    out = std::get<double>(number->value);
+  }
+  pos = number->end;
+  return true;
+}
+
+bool Cursor::readString(std::string& out) {
+  pos = skipWhitespace(input, pos);
+  if (pos >= input.size() || input[pos] != '"') {
+    return false;
+  }
+  auto end = decodeString(input, pos + 1, out);
+  if (!end) {
+    return false;
+  }
+  pos = *end;
+  return true;
+}
+
+bool Cursor::atEnd() {
+  pos = skipWhitespace(input, pos);
+  return pos == input.size();
+}
+}  // namespace jerry::detail
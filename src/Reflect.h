@@ -0,0 +1,368 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Declares the JSON fields of a struct for jerry::parseInto.
+ *
+ *   struct Order { int64_t id; double price; std::vector<Item> items; };
+ *   JERRY_FIELDS(Order, id, price, items)
+ *
+ * Use it at namespace scope, in the namespace of the struct, after the
+ * struct is complete. Each field is matched against the object key spelled
+ * like the member. Members must be accessible from namespace scope.
+ */
+#define JERRY_FIELDS(Type, ...)                                                \
+  [[maybe_unused]] constexpr auto jerryFields(const Type*) {                   \
+    return std::tuple{JERRY_FOR_EACH(JERRY_FIELD_ENTRY, Type, __VA_ARGS__)};   \
+  }
+
+/**
+ * @brief Lets parseInto read an enum from the names of its enumerators.
+ *
+ *   enum class Side { buy, sell };
+ *   JERRY_ENUM(Side, buy, sell)
+ *
+ * Enums without JERRY_ENUM are read from their underlying integer.
+ */
+#define JERRY_ENUM(Type, ...)                                                  \
+  [[maybe_unused]] constexpr auto jerryEnumerators(const Type*) {              \
+    return std::array{JERRY_FOR_EACH(JERRY_ENUM_ENTRY, Type, __VA_ARGS__)};    \
+  }
+
+#define JERRY_FIELD_ENTRY(Type, name)                                          \
+  ::jerry::detail::Field{#name, &Type::name},
+#define JERRY_ENUM_ENTRY(Type, name)                                           \
+  std::pair<std::string_view, Type>{#name, Type::name},
+
+// Applies macro(type, x) to every x, up to 256 of them.
+#define JERRY_FOR_EACH(macro, type, ...)                                       \
+  __VA_OPT__(JERRY_EXPAND(JERRY_FOR_EACH_STEP(macro, type, __VA_ARGS__)))
+#define JERRY_FOR_EACH_STEP(macro, type, first, ...)                           \
+  macro(type, first)                                                           \
+      __VA_OPT__(JERRY_FOR_EACH_AGAIN JERRY_PARENS(macro, type, __VA_ARGS__))
+#define JERRY_FOR_EACH_AGAIN() JERRY_FOR_EACH_STEP
+#define JERRY_PARENS ()
+#define JERRY_EXPAND(...)                                                      \
+  JERRY_EXPAND4(JERRY_EXPAND4(JERRY_EXPAND4(JERRY_EXPAND4(__VA_ARGS__))))
+#define JERRY_EXPAND4(...)                                                     \
+  JERRY_EXPAND3(JERRY_EXPAND3(JERRY_EXPAND3(JERRY_EXPAND3(__VA_ARGS__))))
+#define JERRY_EXPAND3(...)                                                     \
+  JERRY_EXPAND2(JERRY_EXPAND2(JERRY_EXPAND2(JERRY_EXPAND2(__VA_ARGS__))))
+#define JERRY_EXPAND2(...)                                                     \
+  JERRY_EXPAND1(JERRY_EXPAND1(JERRY_EXPAND1(JERRY_EXPAND1(__VA_ARGS__))))
+#define JERRY_EXPAND1(...) __VA_ARGS__
+
+namespace jerry {
+namespace detail {
+template <typename Class, typename Member> struct Field {
+  std::string_view name;
+  Member Class::*member;
+};
+
+/**
+ * @brief A hash table of N field names, built at compile time.
+ *
+ * The hash looks only at a key's length and first and last bytes, so it
+ * costs the same for every key; the seed is the one, of those tried, that
+ * places the declared names with the fewest collisions, which for typical
+ * structs means none. Lookups probe linearly and confirm with a full
+ * comparison, so a key that merely collides is never mistaken for a field.
+ */
+template <size_t N> class KeyIndex {
+public:
+  static_assert(N < UINT16_MAX, "too many fields");
+  static constexpr size_t kSlots = std::bit_ceil(std::max<size_t>(4 * N, 1));
+
+  constexpr explicit KeyIndex(const std::array<std::string_view, N>& names)
+      : names(names) {
+    uint32_t bestSeed = 0;
+    size_t bestDisplacement = SIZE_MAX;
+    for (uint32_t s = 0; s < 64 && bestDisplacement != 0; s++) {
+      size_t displacement = place(s);
+      if (displacement < bestDisplacement) {
+        bestSeed = s;
+        bestDisplacement = displacement;
+      }
+    }
+    place(bestSeed);
+  }
+
+  /** Position of key among the names, or N if it is not one of them. **/
+  constexpr size_t find(std::string_view key) const {
+    constexpr size_t mask = kSlots - 1;
+    for (size_t s = hash(key, seed) & mask; slots[s] != 0;
+         s = (s + 1) & mask) {
+      if (names[slots[s] - 1] == key) {
+        return slots[s] - 1;
+      }
+    }
+    return N;
+  }
+
+private:
+  std::array<std::string_view, N> names;
+  std::array<uint16_t, kSlots> slots{};
+  uint32_t seed = 0;
+
+  static constexpr size_t hash(std::string_view key, uint32_t seed) {
+    uint64_t h = (key.size() + 1) * 0x9E3779B97F4A7C15ull;
+    if (!key.empty()) {
+      h ^= static_cast<unsigned char>(key.front()) * 0xC2B2AE3D27D4EB4Full;
+      h ^= static_cast<unsigned char>(key.back()) * 0x165667B19E3779F9ull;
+    }
+    h = (h ^ seed) * 0xFF51AFD7ED558CCDull;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+
+  // Fills the table with seed s, returning the total probe displacement.
+  constexpr size_t place(uint32_t s) {
+    seed = s;
+    slots = {};
+    size_t displacement = 0;
+    for (size_t i = 0; i < N; i++) {
+      size_t slot = hash(names[i], s) & (kSlots - 1);
+      while (slots[slot] != 0) {
+        slot = (slot + 1) & (kSlots - 1);
+        displacement++;
+      }
+      slots[slot] = static_cast<uint16_t>(i + 1);
+    }
+    return displacement;
+  }
+};
+
+template <typename T>
+concept Reflected = std::is_class_v<T> && requires {
+  jerryFields(static_cast<const T*>(nullptr));
+};
+
+template <typename T>
+concept NamedEnum = std::is_enum_v<T> && requires {
+  jerryEnumerators(static_cast<const T*>(nullptr));
+};
+
+template <typename T> struct IsOptional : std::false_type {};
+template <typename T> struct IsOptional<std::optional<T>> : std::true_type {};
+template <typename T> struct IsVector : std::false_type {};
+template <typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::true_type {};
+
+/**
+ * @brief The read position of parseInto in its input, with the primitive
+ * readers that do not depend on the target type. Defined in Reflect.cpp.
+ */
+class Cursor {
+public:
+  static constexpr size_t kMaxDepth = 1024;
+
+  explicit Cursor(std::string_view input) : input(input), pos(0) {}
+
+  /** Consumes `open` after optional whitespace, entering a container. **/
+  bool open(char open);
+  /** Consumes `close` if it comes next, leaving the container. **/
+  bool close(char close);
+  /** After a member or element: true for ',', false for `close` (leaving
+   * the container), nullopt for anything else. **/
+  std::optional<bool> separator(char close);
+  /** Reads a key and the ':' after it. The view is of the input, or of a
+   * scratch buffer if the key has escapes, and lasts until the next key. **/
+  bool key(std::string_view& out);
+  /** Consumes `null` if it comes next. **/
+  bool null();
+  /** Skips one value without building anything. **/
+  bool skip();
+  bool readBool(bool& out);
+  bool readInt64(int64_t& out);
+  bool readDouble(double& out);
+  bool readString(std::string& out);
+  /** True once only whitespace is left. **/
+  bool atEnd();
+
+private:
+  std::string_view input;
+  size_t pos;
+  size_t depth = 0;
+  std::string scratch;
+};
+
+template <typename T> bool read(Cursor& cursor, T& out);
+
+// Everything parseInto needs to know about a reflected struct, computed once
+// per type at compile time.
+template <Reflected T> struct FieldTable {
+  static constexpr auto fields = jerryFields(static_cast<const T*>(nullptr));
+  static constexpr size_t kCount = std::tuple_size_v<decltype(fields)>;
+
+  static constexpr auto names = std::apply(
+      [](const auto&... field) {
+        return std::array<std::string_view, kCount>{field.name...};
+      },
+      fields);
+
+  static constexpr bool unique() {
+    for (size_t i = 0; i < kCount; i++) {
+      for (size_t j = i + 1; j < kCount; j++) {
+        if (names[i] == names[j]) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+  static_assert(unique(), "JERRY_FIELDS names a field twice");
+
+  static constexpr KeyIndex<kCount> index{names};
+
+  template <size_t I> static bool readField(Cursor& cursor, T& out) {
+    return read(cursor, out.*(std::get<I>(fields).member));
+  }
+
+  // One reader per field, indexed like names: the key lookup picks the
+  // function to call, with no comparison against the other names.
+  using Reader = bool (*)(Cursor&, T&);
+  static constexpr auto readers =
+      []<size_t... I>(std::index_sequence<I...>) {
+        return std::array<Reader, kCount>{&readField<I>...};
+      }(std::make_index_sequence<kCount>());
+};
+
+template <typename T> bool read(Cursor& cursor, T& out) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return cursor.readBool(out);
+  } else if constexpr (std::is_integral_v<T>) {
+    int64_t n;
+    if (!cursor.readInt64(n) || !std::in_range<T>(n)) {
+      return false;
+    }
+    out = static_cast<T>(n);
+    return true;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    double d;
+    if (!cursor.readDouble(d)) {
+      return false;
+    }
+    out = static_cast<T>(d);
+    return true;
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return cursor.readString(out);
+  } else if constexpr (NamedEnum<T>) {
+    static constexpr auto enumerators =
+        jerryEnumerators(static_cast<const T*>(nullptr));
+    std::string name;
+    if (!cursor.readString(name)) {
+      return false;
+    }
+    for (const auto& [enumeratorName, value] : enumerators) {
+      if (enumeratorName == name) {
+        out = value;
+        return true;
+      }
+    }
+    return false;
+  } else if constexpr (std::is_enum_v<T>) {
+    std::underlying_type_t<T> n;
+    if (!read(cursor, n)) {
+      return false;
+    }
+    out = static_cast<T>(n);
+    return true;
+  } else if constexpr (IsOptional<T>::value) {
+    if (cursor.null()) {
+      out.reset();
+      return true;
+    }
+    return read(cursor, out.emplace());
+  } else if constexpr (IsVector<T>::value) {
+    out.clear();
+    if (!cursor.open('[')) {
+      return false;
+    }
+    if (cursor.close(']')) {
+      return true;
+    }
+    while (true) {
+      if (!read(cursor, out.emplace_back())) {
+        return false;
+      }
+      auto more = cursor.separator(']');
+      if (!more) {
+        return false;
+      }
+      if (!*more) {
+        return true;
+      }
+    }
+  } else if constexpr (Reflected<T>) {
+    using Table = FieldTable<T>;
+    if (!cursor.open('{')) {
+      return false;
+    }
+    if (cursor.close('}')) {
+      return true;
+    }
+    while (true) {
+      std::string_view key;
+      if (!cursor.key(key)) {
+        return false;
+      }
+      size_t field = Table::index.find(key);
+      bool ok = field < Table::kCount ? Table::readers[field](cursor, out)
+                                      : cursor.skip();
+      if (!ok) {
+        return false;
+      }
+      auto more = cursor.separator('}');
+      if (!more) {
+        return false;
+      }
+      if (!*more) {
+        return true;
+      }
+    }
+  } else {
+    static_assert(!sizeof(T), "parseInto cannot read this type; declare "
+                              "its fields with JERRY_FIELDS");
+  }
+}
+}  // namespace detail
+
+/**
+ * @brief Parses input straight into out, without building a JsonValue.
+ *
+ * Supported members are bool, integers (rejected if out of range), floating
+ * point, std::string, enums (by name with JERRY_ENUM, otherwise by value),
+ * std::optional (null resets it), std::vector and nested JERRY_FIELDS
+ * structs. Keys are matched through a table built at compile time for each
+ * struct. Unknown keys are skipped without being parsed or validated,
+ * missing keys leave their member untouched and a repeated key is read
+ * again, so the last one wins.
+ *
+ * @return false if the input is not a single value of T's shape; out may
+ * then be partly written.
+ */
+template <detail::Reflected T> bool parseInto(std::string_view input, T& out) {
+  detail::Cursor cursor(input);
+  return detail::read(cursor, out) && cursor.atEnd();
+}
+
+/** As above, into a default-constructed T. **/
+template <detail::Reflected T>
+std::optional<T> parseInto(std::string_view input) {
+  T out{};
+  if (!parseInto(input, out)) {
+    return std::nullopt;
+  }
+  return out;
+}
+}  // namespace jerry
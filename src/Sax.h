@@ -0,0 +1,179 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Json.h"
+#include "Reader.h"
+
+namespace jerry {
+/**
+ * @brief A push-style consumer of parse events.
+ *
+ * Each callback returns true to continue or false to stop parsing:
+ *
+ *   bool onObjectStart();  bool onObjectEnd();
+ *   bool onArrayStart();   bool onArrayEnd();
+ *   bool onKey(std::string_view);
+ *   bool onString(std::string_view);
+ *   bool onNumber(int64_t);  bool onNumber(double);
+ *   bool onBool(bool);
+ *   bool onNull();
+ *
+ * Integers that fit in int64_t are passed as int64_t, all other numbers as
+ * double, so a handler that only cares about doubles can define a single
+ * onNumber(double). The views passed to onKey()/onString() are decoded and
+ * only valid for the duration of the call.
+ */
+template <typename Handler>
+concept SaxHandler = requires(Handler& h, std::string_view s, bool b) {
+  { h.onObjectStart() } -> std::convertible_to<bool>;
+  { h.onObjectEnd() } -> std::convertible_to<bool>;
+  { h.onArrayStart() } -> std::convertible_to<bool>;
+  { h.onArrayEnd() } -> std::convertible_to<bool>;
+  { h.onKey(s) } -> std::convertible_to<bool>;
+  { h.onString(s) } -> std::convertible_to<bool>;
+  { h.onNumber(int64_t{}) } -> std::convertible_to<bool>;
+  { h.onNumber(double{}) } -> std::convertible_to<bool>;
+  { h.onBool(b) } -> std::convertible_to<bool>;
+  { h.onNull() } -> std::convertible_to<bool>;
+};
+
+enum class SaxStatus {
+  /** The whole document was parsed. **/
+  Complete,
+  /** A callback returned false. **/
+  Stopped,
+  /** The input is not valid JSON. **/
+  Error
+};
+
+struct SaxResult {
+  SaxStatus status;
+  /** Offset of the next unread byte: the end of the input when complete,
+   * otherwise where parsing stopped or failed. **/
+  size_t position;
+
+  explicit operator bool() const noexcept {
+    return status == SaxStatus::Complete;
+  }
+};
+
+namespace detail {
+// Forwards Reader callbacks to a SaxHandler, remembering whether parsing
+// ended because the handler asked it to.
+template <SaxHandler Handler> class SaxAdapter {
+public:
+  explicit SaxAdapter(Handler& handler) : handler(handler) {}
+
+  bool stopped = false;
+
+  bool beginArray() { return forward(handler.onArrayStart()); }
+  bool endArray(size_t) { return forward(handler.onArrayEnd()); }
+  bool beginObject() { return forward(handler.onObjectStart()); }
+  bool endObject(size_t) { return forward(handler.onObjectEnd()); }
+  bool key(std::string_view s) { return forward(handler.onKey(s)); }
+  bool string(std::string_view s) { return forward(handler.onString(s)); }
+  bool number(const ParsedNumber& n, std::string_view) {
+    return forward(
+        std::visit([this](auto v) -> bool { return handler.onNumber(v); },
+                   n.value));
+  }
+  bool boolean(bool b) { return forward(handler.onBool(b)); }
+  bool null() { return forward(handler.onNull()); }
+
+private:
+  Handler& handler;
+
+  bool forward(bool keepGoing) {
+    stopped = !keepGoing;
+    return keepGoing;
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Parses one JSON document, reporting each token to handler.
+ *
+ * No DOM is built: memory use is the nesting depth plus the longest string,
+ * however large the input. The handler type is a template parameter, so
+ * every callback is statically dispatched.
+ */
+template <SaxHandler Handler>
+SaxResult parseSax(std::string_view input, Handler& handler) {
+  detail::SaxAdapter<Handler> adapter(handler);
+  detail::Reader<detail::SaxAdapter<Handler>> reader(input, adapter);
+  if (reader.parseDocument()) {
+    return {SaxStatus::Complete, reader.position()};
+  }
+  return {adapter.stopped ? SaxStatus::Stopped : SaxStatus::Error,
+          reader.position()};
+}
+
+/**
+ * @brief A SaxHandler that assembles the events into a JsonValue.
+ *
+ * parseSax with this handler produces the same value as Json::fromString;
+ * it is mainly useful as a base for handlers that build part of a document.
+ */
+class JsonValueHandler {
+public:
+  bool onObjectStart() {
+    stack.push_back({JsonValue(JsonObject()), std::string()});
+    return true;
+  }
+  bool onArrayStart() {
+    stack.push_back({JsonValue(std::vector<JsonValue>()), std::string()});
+    return true;
+  }
+  bool onObjectEnd() { return close(); }
+  bool onArrayEnd() { return close(); }
+  bool onKey(std::string_view s) {
+    stack.back().key = s;
+    return true;
+  }
+  bool onString(std::string_view s) { return add(JsonValue(std::string(s))); }
+  bool onNumber(int64_t n) { return add(JsonValue(n)); }
+  bool onNumber(double n) { return add(JsonValue(n)); }
+  bool onBool(bool b) { return add(JsonValue(b)); }
+  bool onNull() { return add(JsonValue()); }
+
+  /** The completed document. **/
+  JsonValue& getValue() noexcept { return result; }
+
+private:
+  struct Frame {
+    JsonValue container;
+    std::string key;
+  };
+  std::vector<Frame> stack;
+  JsonValue result;
+
+  bool add(JsonValue value) {
+    if (stack.empty()) {
+      result = std::move(value);
+      return true;
+    }
+    Frame& top = stack.back();
+    auto& container = top.container.value;
+    if (auto array = std::get_if<std::vector<JsonValue>>(&container)) {
+      array->push_back(std::move(value));
+    } else {
+      std::get<JsonObject>(container).insert_or_assign(top.key,
+                                                       std::move(value));
+    }
+    return true;
+  }
+
+  bool close() {
+    JsonValue done = std::move(stack.back().container);
+    stack.pop_back();
+    return add(std::move(done));
+  }
+};
+}  // namespace jerry
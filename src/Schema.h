@@ -0,0 +1,391 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "Json.h"
+#include "NumberParser.h"
+#include "Skip.h"
+#include "StringDecoder.h"
+#include "Tokenizer.h"
+
+/**
+ * Schema-specialized parsers for messages whose shape is fixed at build time.
+ *
+ *   using Trade = schema::Object<
+ *       schema::Required<"id", int64_t>,
+ *       schema::Required<"price", double>,
+ *       schema::Optional<"venue", std::string>>;
+ *
+ *   auto parser = schema::tokenizer<Trade>();  // yields Trade::Record
+ *   auto trade = parser.run(TokenizerState(input, 0));
+ *   int64_t id = trade->first.get<"id">();
+ *
+ * Field types are bool, integers, floating point, std::string, nested
+ * schema::Object types and std::vectors of any of those. Everything about a
+ * field (its key bytes, its reader, where it is stored) is fixed at compile
+ * time, so the parser is one straight-line function per schema.
+ *
+ * The parser expects keys in declaration order: each key is first compared
+ * with the field after the previous one, 8 bytes at a time against
+ * precomputed words, and only on a mismatch with the other fields. Anything
+ * the schema does not describe (an unknown or escaped key, a repeated key, a
+ * missing required field, a value of another type) makes the parse fail, so
+ * that schema::orJson<S>() can hand the message to Json::fromState instead.
+ */
+namespace jerry::schema {
+/** A string literal usable as a template argument. **/
+template <size_t N> struct FixedString {
+  char chars[N]{};
+
+  constexpr FixedString(const char (&s)[N]) { std::copy_n(s, N, chars); }
+  constexpr std::string_view view() const { return {chars, N - 1}; }
+  constexpr size_t size() const { return N - 1; }
+};
+
+enum class Presence { Required, Optional };
+
+template <FixedString Name, typename T, Presence P> struct Field {
+  static constexpr std::string_view name = Name.view();
+  static constexpr bool required = P == Presence::Required;
+  using type = T;
+};
+
+/** A field that must be present. **/
+template <FixedString Name, typename T>
+using Required = Field<Name, T, Presence::Required>;
+
+/** A field that may be missing or null; stored as std::optional. **/
+template <FixedString Name, typename T>
+using Optional = Field<Name, T, Presence::Optional>;
+
+template <typename... Fields> struct Object;
+
+namespace detail {
+// What a field of schema type T is parsed into.
+template <typename T> struct Stored {
+  using type = T;
+};
+template <typename... F> struct Stored<Object<F...>> {
+  using type = typename Object<F...>::Record;
+};
+template <typename T> struct Stored<std::vector<T>> {
+  using type = std::vector<typename Stored<T>::type>;
+};
+
+template <typename Field>
+using StoredType = typename Stored<typename Field::type>::type;
+
+template <typename Field>
+using StoredField = std::conditional_t<Field::required, StoredType<Field>,
+                                       std::optional<StoredType<Field>>>;
+
+/**
+ * @brief The bytes of a key and its closing quote as 64-bit words.
+ *
+ * matches() compares a word at a time under a mask for the last, partial
+ * word, falling back to memcmp only within 8 bytes of the end of the input.
+ */
+template <size_t Length> struct KeyPattern {
+  static constexpr size_t kWords = (Length + 7) / 8;
+  std::array<char, Length> bytes{};
+  std::array<uint64_t, kWords> words{};
+  std::array<uint64_t, kWords> masks{};
+
+  constexpr explicit KeyPattern(std::string_view name) {
+    for (size_t i = 0; i < Length; i++) {
+      bytes[i] = i < name.size() ? name[i] : '"';
+      size_t shift = std::endian::native == std::endian::little
+                         ? 8 * (i % 8)
+                         : 8 * (7 - i % 8);
+      words[i / 8] |= uint64_t{static_cast<unsigned char>(bytes[i])} << shift;
+      masks[i / 8] |= uint64_t{0xFF} << shift;
+    }
+  }
+
+  bool matches(std::string_view input, size_t pos) const {
+    if (input.size() - pos >= 8 * kWords) {
+      for (size_t w = 0; w < kWords; w++) {
+        uint64_t word;
+        std::memcpy(&word, input.data() + pos + 8 * w, 8);
+        if ((word & masks[w]) != words[w]) {
+          return false;
+        }
+      }
+      return true;
+    }
+    return input.size() - pos >= Length &&
+           std::memcmp(input.data() + pos, bytes.data(), Length) == 0;
+  }
+};
+
+template <typename Field>
+inline constexpr KeyPattern<Field::name.size() + 1> kKey{Field::name};
+
+// Calls f(std::integral_constant<size_t, I>) for the I equal to i; false if
+// there is none or f returns false. The fold compiles to a jump over the
+// constant indices, so each arm is inlined.
+template <typename F, size_t... I>
+bool dispatch(size_t i, F&& f, std::index_sequence<I...>) {
+  return ((i == I && f(std::integral_constant<size_t, I>())) || ...);
+}
+
+struct Cursor {
+  std::string_view input;
+  size_t pos;
+
+  void skipSpaces() { pos = skipWhitespace(input, pos); }
+
+  bool consume(char c) {
+    skipSpaces();
+    if (pos >= input.size() || input[pos] != c) {
+      return false;
+    }
+    pos++;
+    return true;
+  }
+
+  bool literal(std::string_view word) {
+    if (input.substr(pos, word.size()) != word) {
+      return false;
+    }
+    pos += word.size();
+    return true;
+  }
+};
+
+inline constexpr size_t kMaxDepth = Json::kMaxDepth;
+
+template <typename T> bool readValue(Cursor& c, T& out, size_t depth);
+
+template <typename... Fields>
+bool readObject(Cursor& c, typename Object<Fields...>::Record& out,
+                size_t depth) {
+  constexpr size_t kCount = sizeof...(Fields);
+  static_assert(kCount <= 64, "schema objects are limited to 64 fields");
+  constexpr uint64_t kRequired = [] {
+    uint64_t mask = 0;
+    size_t i = 0;
+    ((mask |= uint64_t{Fields::required} << i++), ...);
+    return mask;
+  }();
+  using Indices = std::make_index_sequence<kCount>;
+
+  if (depth > kMaxDepth || !c.consume('{')) {
+    return false;
+  }
+  uint64_t seen = 0;
+  if (c.consume('}')) {
+    return kRequired == 0;
+  }
+  size_t expected = 0;
+  while (true) {
+    if (!c.consume('"')) {
+      return false;
+    }
+    auto matchAt = [&c](auto i) {
+      using F = std::tuple_element_t<i, std::tuple<Fields...>>;
+      return kKey<F>.matches(c.input, c.pos);
+    };
+    size_t field = kCount;
+    if (dispatch(expected, matchAt, Indices())) {
+      field = expected;
+    } else {
+      for (size_t i = 0; i < kCount; i++) {
+        if (i != expected && dispatch(i, matchAt, Indices())) {
+          field = i;
+          break;
+        }
+      }
+    }
+    if (field == kCount || ((seen >> field) & 1)) {
+      return false;
+    }
+    auto read = [&c, &out, depth](auto i) {
+      using F = std::tuple_element_t<i, std::tuple<Fields...>>;
+      c.pos += F::name.size() + 1;
+      return c.consume(':') &&
+             readValue(c, std::get<i>(out.values), depth);
+    };
+    if (!dispatch(field, read, Indices())) {
+      return false;
+    }
+    seen |= uint64_t{1} << field;
+    expected = field + 1;
+    if (c.consume('}')) {
+      return (seen & kRequired) == kRequired;
+    }
+    if (!c.consume(',')) {
+      return false;
+    }
+  }
+}
+
+template <typename T> bool readValue(Cursor& c, T& out, size_t depth) {
+  c.skipSpaces();
+  if constexpr (std::is_same_v<T, bool>) {
+    if (c.literal("true")) {
+      out = true;
+      return true;
+    }
+    out = false;
+    return c.literal("false");
+  } else if constexpr (std::is_integral_v<T>) {
+    auto number = parseNumber(c.input, c.pos);
+    if (!number) {
+      return false;
+    }
+    auto* n = std::get_if<int64_t>(&number->value);
+    if (!n || !std::in_range<T>(*n)) {
+      return false;
+    }
+    out = static_cast<T>(*n);
+    c.pos = number->end;
+    return true;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    auto number = parseNumber(c.input, c.pos);
+    if (!number) {
+      return false;
+    }
+    out = std::visit([](auto n) { return static_cast<T>(n); }, number->value);
+    c.pos = number->end;
+    return true;
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    if (c.pos >= c.input.size() || c.input[c.pos] != '"') {
+      return false;
+    }
+    auto end = decodeString(c.input, c.pos + 1, out);
+    if (!end) {
+      return false;
+    }
+    c.pos = *end;
+    return true;
+  } else if constexpr (requires { typename T::Schema; }) {
+    return [&]<typename... F>(Object<F...>*) {
+      return readObject<F...>(c, out, depth + 1);
+    }(static_cast<typename T::Schema*>(nullptr));
+  } else if constexpr (requires { typename T::value_type; }) {
+    // A field declared std::optional<...> by schema::Optional.
+    if constexpr (std::is_same_v<T, std::optional<typename T::value_type>>) {
+      if (c.literal("null")) {
+        out.reset();
+        return true;
+      }
+      return readValue(c, out.emplace(), depth);
+    } else {
+      out.clear();
+      if (depth >= kMaxDepth || !c.consume('[')) {
+        return false;
+      }
+      if (c.consume(']')) {
+        return true;
+      }
+      while (true) {
+        if (!readValue(c, out.emplace_back(), depth + 1)) {
+          return false;
+        }
+        if (c.consume(']')) {
+          return true;
+        }
+        if (!c.consume(',')) {
+          return false;
+        }
+      }
+    }
+  } else {
+    static_assert(!sizeof(T), "unsupported schema field type");
+  }
+}
+
+template <FixedString Name, typename... Fields>
+constexpr size_t indexOf() {
+  constexpr std::array<std::string_view, sizeof...(Fields)> names = {
+      Fields::name...};
+  for (size_t i = 0; i < names.size(); i++) {
+    if (names[i] == Name.view()) {
+      return i;
+    }
+  }
+  return names.size();
+}
+}  // namespace detail
+
+/** An object schema: its fields, in the order messages usually have them. **/
+template <typename... Fields> struct Object {
+  /** A parsed message: one member per field, in declaration order. **/
+  struct Record {
+    using Schema = Object;
+
+    std::tuple<detail::StoredField<Fields>...> values;
+
+    template <FixedString Name> auto& get() {
+      constexpr size_t i = detail::indexOf<Name, Fields...>();
+      static_assert(i < sizeof...(Fields), "no such field in the schema");
+      return std::get<i>(values);
+    }
+
+    template <FixedString Name> const auto& get() const {
+      constexpr size_t i = detail::indexOf<Name, Fields...>();
+      static_assert(i < sizeof...(Fields), "no such field in the schema");
+      return std::get<i>(values);
+    }
+
+    bool operator==(const Record& other) const = default;
+  };
+};
+
+/**
+ * @brief A StaticTokenizer that parses one message of schema S, after
+ * optional whitespace, into an S::Record. Fails on anything S does not
+ * describe.
+ */
+template <typename S> static auto tokenizer() {
+  using Record = typename S::Record;
+  return makeTokenizer<Record>(
+      Combinator::Schema, [](TokenizerState state) -> TokenizerResult<Record> {
+        detail::Cursor cursor{state.getInputString(), state.getPosition()};
+        Record record;
+        if (!detail::readValue(cursor, record, 0)) {
+          return std::nullopt;
+        }
+        return std::make_pair(std::move(record),
+                              state.advance(cursor.pos - state.getPosition()));
+      });
+}
+
+/** What orJson produces: the record, or the generic value for a miss. **/
+template <typename S>
+using RecordOrJson = std::variant<typename S::Record, JsonValue>;
+
+/**
+ * @brief tokenizer<S>() with Json::fromState as the fallback, so messages
+ * that stray from the schema are still parsed, just generically.
+ */
+template <typename S> static auto orJson() {
+  using Result = RecordOrJson<S>;
+  auto generic = makeTokenizer<JsonValue>(
+      [](TokenizerState state) -> TokenizerResult<JsonValue> {
+        auto json = Json::fromState(state);
+        if (!json) {
+          return std::nullopt;
+        }
+        return std::make_pair(std::move(json->first).getValue(), json->second);
+      });
+  return orElse(
+      tokenizer<S>().template map<Result>(
+          [](typename S::Record record) { return Result(std::move(record)); }),
+      generic.template map<Result>(
+          [](JsonValue value) { return Result(std::move(value)); }));
+}
+}  // namespace jerry::schema
@@ -0,0 +1,119 @@
+#include "Skip.h"
+
+#include "StringDecoder.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace jerry {
+namespace {
+bool isWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isDelimiter(char c) {
+  return isWhitespace(c) || c == ',' || c == ']' || c == '}' || c == ':';
+}
+
+bool isContainerSpecial(char c) {
+  return c == '"' || c == '[' || c == ']' || c == '{' || c == '}';
+}
+
+// Offset of the next quote or bracket at or after pos, 16 bytes at a time.
+size_t findContainerSpecial(std::string_view input, size_t pos) {
+  const char* data = input.data();
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i openBracket = _mm_set1_epi8('[');
+  const __m128i closeBracket = _mm_set1_epi8(']');
+  const __m128i openBrace = _mm_set1_epi8('{');
+  const __m128i closeBrace = _mm_set1_epi8('}');
+  for (; pos + 16 <= input.size(); pos += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, openBracket)),
+        _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, closeBracket),
+                         _mm_cmpeq_epi8(chunk, openBrace)),
+            _mm_cmpeq_epi8(chunk, closeBrace)));
+    int mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return pos + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+  while (pos < input.size() && !isContainerSpecial(data[pos])) {
+    pos++;
+  }
+  return pos;
+}
+
+std::optional<size_t> skipContainer(std::string_view input, size_t pos) {
+  size_t depth = 0;
+  while ((pos = findContainerSpecial(input, pos)) < input.size()) {
+    switch (input[pos]) {
+      case '"': {
+        auto end = skipString(input, pos + 1);
+        if (!end) {
+          return std::nullopt;
+        }
+        pos = *end;
+        continue;
+      }
+      case '[':
+      case '{':
+        depth++;
+        break;
+      case ']':
+      case '}':
+        if (depth == 0) {
+          return std::nullopt;
+        }
+        if (--depth == 0) {
+          return pos + 1;
+        }
+        break;
+      default:
+        break;
+    }
+    pos++;
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+size_t skipWhitespace(std::string_view input, size_t pos) noexcept {
+  while (pos < input.size() && isWhitespace(input[pos])) {
+    pos++;
+  }
+  return pos;
+}
+
+std::optional<size_t> skipValue(std::string_view input, size_t pos) noexcept {
+  if (pos >= input.size()) {
+    return std::nullopt;
+  }
+  switch (input[pos]) {
+    case '"':
+      return skipString(input, pos + 1);
+    case '[':
+    case '{':
+      return skipContainer(input, pos);
+    case ']':
+    case '}':
+    case ',':
+    case ':':
+      return std::nullopt;
+    default: {
+      size_t end = pos;
+      while (end < input.size() && !isDelimiter(input[end])) {
+        end++;
+      }
+      return end;
+    }
+  }
+}
+}  // namespace jerry
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace jerry {
+/** Returns the offset of the first non-whitespace byte at or after pos. **/
+size_t skipWhitespace(std::string_view input, size_t pos) noexcept;
+
+/**
+ * @brief Finds the end of the value starting at pos without parsing it.
+ *
+ * Strings are skipped with the vectorized string scanner, containers by
+ * counting brackets outside of strings, and numbers/literals by running to
+ * the next delimiter. Only the structure needed to find the end is checked:
+ * the contents of a skipped container are not validated.
+ *
+ * @return The offset just past the value, or nullopt if the input ends before
+ * the value does or its brackets do not balance.
+ */
+std::optional<size_t> skipValue(std::string_view input, size_t pos) noexcept;
+}  // namespace jerry
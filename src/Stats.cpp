@@ -0,0 +1,131 @@
+#include "Stats.h"
+
+#include <atomic>
+
+#include "Json.h"
+#include "Writer.h"
+
+namespace jerry {
+namespace {
+constexpr size_t kCombinators = static_cast<size_t>(Combinator::Count);
+
+struct AtomicCombinatorStats {
+  std::atomic<uint64_t> invocations{0};
+  std::atomic<uint64_t> failures{0};
+  std::atomic<uint64_t> bytesConsumed{0};
+  std::atomic<uint64_t> backtracks{0};
+  std::atomic<uint64_t> backtrackedBytes{0};
+};
+
+struct Counters {
+  std::array<AtomicCombinatorStats, kCombinators> combinators;
+  std::atomic<uint64_t> stateCopies{0};
+  std::atomic<uint64_t> closuresBuilt{0};
+  std::atomic<uint64_t> allocations{0};
+};
+
+Counters counters;
+
+void add(std::atomic<uint64_t>& counter, uint64_t n = 1) noexcept {
+  counter.fetch_add(n, std::memory_order_relaxed);
+}
+
+uint64_t load(const std::atomic<uint64_t>& counter) noexcept {
+  return counter.load(std::memory_order_relaxed);
+}
+
+AtomicCombinatorStats& of(Combinator c) noexcept {
+  return counters.combinators[static_cast<size_t>(c)];
+}
+}  // namespace
+
+std::string_view combinatorName(Combinator combinator) {
+  static constexpr std::string_view kNames[] = {
+      "character", "expectChar", "expectString", "bind",
+      "map",       "orElse",     "manyOf",       "skipMany",
+      "constant",  "jsonString", "jsonNumber",   "schema",
+      "erased",    "custom"};
+  static_assert(std::size(kNames) == kCombinators);
+  return kNames[static_cast<size_t>(combinator)];
+}
+
+Stats stats() {
+  Stats snapshot;
+  for (size_t i = 0; i < kCombinators; i++) {
+    const auto& from = counters.combinators[i];
+    auto& to = snapshot.combinators[i];
+    to.invocations = load(from.invocations);
+    to.failures = load(from.failures);
+    to.bytesConsumed = load(from.bytesConsumed);
+    to.backtracks = load(from.backtracks);
+    to.backtrackedBytes = load(from.backtrackedBytes);
+  }
+  snapshot.stateCopies = load(counters.stateCopies);
+  snapshot.closuresBuilt = load(counters.closuresBuilt);
+  snapshot.allocations = load(counters.allocations);
+  return snapshot;
+}
+
+void resetStats() {
+  for (auto& c : counters.combinators) {
+    c.invocations = 0;
+    c.failures = 0;
+    c.bytesConsumed = 0;
+    c.backtracks = 0;
+    c.backtrackedBytes = 0;
+  }
+  counters.stateCopies = 0;
+  counters.closuresBuilt = 0;
+  counters.allocations = 0;
+}
+
+std::string Stats::toJson(bool pretty) const {
+  auto number = [](uint64_t n) { return JsonValue(static_cast<int64_t>(n)); };
+  JsonObject perCombinator;
+  for (size_t i = 0; i < kCombinators; i++) {
+    const CombinatorStats& c = combinators[i];
+    perCombinator.insert_or_assign(
+        std::string(combinatorName(static_cast<Combinator>(i))),
+        JsonObject{{"invocations", number(c.invocations)},
+                   {"failures", number(c.failures)},
+                   {"bytesConsumed", number(c.bytesConsumed)},
+                   {"backtracks", number(c.backtracks)},
+                   {"backtrackedBytes", number(c.backtrackedBytes)}});
+  }
+  JsonObject root{{"enabled", JsonValue(kStatsEnabled)},
+                  {"combinators", JsonValue(std::move(perCombinator))},
+                  {"stateCopies", number(stateCopies)},
+                  {"closuresBuilt", number(closuresBuilt)},
+                  {"allocations", number(allocations)}};
+  return jerry::toJson(JsonValue(std::move(root)), {.pretty = pretty});
+}
+
+namespace detail {
+void recordRunSlow(Combinator c, bool matched, size_t consumed) noexcept {
+  auto& s = of(c);
+  add(s.invocations);
+  if (matched) {
+    add(s.bytesConsumed, consumed);
+  } else {
+    add(s.failures);
+  }
+}
+
+void recordBacktrackSlow(Combinator c, size_t bytes) noexcept {
+  auto& s = of(c);
+  add(s.backtracks);
+  add(s.backtrackedBytes, bytes);
+}
+
+void recordStateCopySlow() noexcept { add(counters.stateCopies); }
+
+void recordClosureSlow(bool allocates) noexcept {
+  add(counters.closuresBuilt);
+  if (allocates) {
+    add(counters.allocations);
+  }
+}
+
+void recordAllocationSlow() noexcept { add(counters.allocations); }
+}  // namespace detail
+}  // namespace jerry
@@ -0,0 +1,123 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#ifndef JERRY_STATS
+#define JERRY_STATS 0
+#endif
+
+namespace jerry {
+/** True when the library was built with -DJERRY_STATS=ON. **/
+inline constexpr bool kStatsEnabled = JERRY_STATS != 0;
+
+/** The combinators of Tokenizer.h that keep their own counters. **/
+enum class Combinator : uint8_t {
+  Character,
+  ExpectChar,
+  ExpectString,
+  Bind,
+  Map,
+  OrElse,
+  ManyOf,
+  SkipMany,
+  Constant,
+  JsonString,
+  JsonNumber,
+  /** Schema-specialized parsers (see Schema.h). **/
+  Schema,
+  /** Runs of a type-erased Tokenizer<T>. **/
+  Erased,
+  /** Tokenizers built with makeTokenizer outside Tokenizer.h. **/
+  Custom,
+  Count
+};
+
+std::string_view combinatorName(Combinator combinator);
+
+struct CombinatorStats {
+  uint64_t invocations = 0;
+  uint64_t failures = 0;
+  /** Input consumed by successful runs. **/
+  uint64_t bytesConsumed = 0;
+  /** Runs that threw away a partial match: an orElse that fell back to its
+   * second alternative, or a bind whose continuation failed. **/
+  uint64_t backtracks = 0;
+  /** Input a bind had matched before its continuation failed. **/
+  uint64_t backtrackedBytes = 0;
+};
+
+/**
+ * @brief A snapshot of the combinator engine's counters.
+ *
+ * Counting is compiled in only with -DJERRY_STATS=ON; otherwise every
+ * hook is discarded at compile time and stats() returns zeros. Counters are
+ * process-wide and updated with relaxed atomics, so concurrent parses are
+ * summed.
+ */
+struct Stats {
+  std::array<CombinatorStats, static_cast<size_t>(Combinator::Count)>
+      combinators{};
+  /** TokenizerState copies made while running tokenizers. **/
+  uint64_t stateCopies = 0;
+  /** Tokenizer closures constructed, static and type-erased. **/
+  uint64_t closuresBuilt = 0;
+  /** Heap allocations made by combinators: erased closures too large for
+   * std::function's inline buffer, growth of manyOf's vector, and strings
+   * that outgrow the small-string buffer. **/
+  uint64_t allocations = 0;
+
+  const CombinatorStats& operator[](Combinator c) const {
+    return combinators[static_cast<size_t>(c)];
+  }
+
+  /** The snapshot as a JSON object keyed by combinator name. **/
+  std::string toJson(bool pretty = true) const;
+};
+
+/** The counters accumulated since start-up or the last resetStats(). **/
+Stats stats();
+void resetStats();
+
+namespace detail {
+void recordRunSlow(Combinator c, bool matched, size_t consumed) noexcept;
+void recordBacktrackSlow(Combinator c, size_t bytes) noexcept;
+void recordStateCopySlow() noexcept;
+void recordClosureSlow(bool allocates) noexcept;
+void recordAllocationSlow() noexcept;
+
+// The hooks below vanish entirely unless JERRY_STATS is set.
+
+inline void recordRun(Combinator c, bool matched, size_t consumed) noexcept {
+  if constexpr (kStatsEnabled) {
+    recordRunSlow(c, matched, consumed);
+  }
+}
+
+inline void recordBacktrack(Combinator c, size_t bytes) noexcept {
+  if constexpr (kStatsEnabled) {
+    recordBacktrackSlow(c, bytes);
+  }
+}
+
+inline void recordStateCopy() noexcept {
+  if constexpr (kStatsEnabled) {
+    recordStateCopySlow();
+  }
+}
+
+inline void recordClosure(bool allocates = false) noexcept {
+  if constexpr (kStatsEnabled) {
+    recordClosureSlow(allocates);
+  }
+}
+
+inline void recordAllocation() noexcept {
+  if constexpr (kStatsEnabled) {
+    recordAllocationSlow();
+  }
+}
+}  // namespace detail
+}  // namespace jerry
@@ -0,0 +1,330 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "NumberParser.h"
+#include "Reader.h"
+#include "Sax.h"
+#include "StringDecoder.h"
+
+namespace jerry {
+/**
+ * @brief A push parser that accepts a document in arbitrary chunks.
+ *
+ * Bytes are fed as they arrive and SAX events are delivered to the handler
+ * as soon as each token is complete. A token cut by a chunk boundary (a
+ * string, number or literal) is carried over in a small buffer; everything
+ * else is parsed straight out of the chunk, which need not outlive feed().
+ * Memory use is the nesting depth plus the longest single token.
+ *
+ *   StreamParser parser(handler);
+ *   while (auto chunk = read()) {
+ *     if (!parser.feed(*chunk)) break;
+ *   }
+ *   SaxResult result = parser.finish();
+ *
+ * A number at the very end of the input is only reported by finish(), since
+ * until then more digits may follow.
+ */
+template <SaxHandler Handler> class StreamParser {
+public:
+  // Same limit as Json::fromString.
+  static constexpr size_t kMaxDepth = 1024;
+
+  explicit StreamParser(Handler& handler) : handler(handler) {}
+
+  /** Parses chunk. Returns false once the handler has stopped parsing or the
+   * input has turned out to be invalid; further input is then ignored. **/
+  bool feed(std::span<const char> chunk) {
+    if (outcome != Outcome::Running) {
+      return false;
+    }
+    std::string_view in(chunk.data(), chunk.size());
+    size_t pos = 0;
+    while (pos < in.size() && outcome == Outcome::Running) {
+      switch (state) {
+        case State::String:
+          continueString(in, pos);
+          break;
+        case State::Scalar:
+          continueScalar(in, pos);
+          break;
+        default:
+          if (detail::isJsonWhitespace(in[pos])) {
+            pos++;
+          } else {
+            structural(in, pos);
+          }
+      }
+    }
+    consumed += pos;
+    return outcome == Outcome::Running;
+  }
+
+  /** Signals the end of input and reports whether a complete document was
+   * parsed. **/
+  SaxResult finish() {
+    if (outcome == Outcome::Running && state == State::Scalar) {
+      finishScalar(token);
+    }
+    switch (outcome) {
+      case Outcome::Stopped:
+        return {SaxStatus::Stopped, consumed};
+      case Outcome::Error:
+        return {SaxStatus::Error, consumed};
+      default:
+        return {state == State::Done ? SaxStatus::Complete : SaxStatus::Error,
+                consumed};
+    }
+  }
+
+  /** Total bytes consumed so far. **/
+  size_t position() const noexcept { return consumed; }
+
+private:
+  enum class State : uint8_t {
+    Value,         // any value
+    FirstElement,  // a value or ']'
+    FirstKey,      // a key or '}'
+    Key,           // a key
+    Colon,         // ':'
+    AfterValue,    // ',' or the closing bracket
+    Done,          // only whitespace may follow
+    String,        // inside a string that began in an earlier chunk
+    Scalar         // inside a number or literal
+  };
+  enum class Outcome : uint8_t { Running, Stopped, Error };
+
+  Handler& handler;
+  State state = State::Value;
+  Outcome outcome = Outcome::Running;
+  // '[' or '{' for each open container.
+  std::vector<char> containers;
+  // The partial token, including the opening quote for strings.
+  std::string token;
+  std::string scratch;
+  bool tokenIsKey = false;
+  bool pendingEscape = false;
+  size_t consumed = 0;
+
+  void fail() { outcome = Outcome::Error; }
+
+  void emit(bool keepGoing) {
+    if (!keepGoing) {
+      outcome = Outcome::Stopped;
+    }
+  }
+
+  void valueDone() {
+    state = containers.empty() ? State::Done : State::AfterValue;
+  }
+
+  // Handles a byte outside of any token.
+  void structural(std::string_view in, size_t& pos) {
+    char c = in[pos];
+    switch (state) {
+      case State::FirstElement:
+        if (c == ']') {
+          pos++;
+          close(c);
+          return;
+        }
+        beginValue(in, pos);
+        return;
+      case State::Value:
+        beginValue(in, pos);
+        return;
+      case State::FirstKey:
+        if (c == '}') {
+          pos++;
+          close(c);
+          return;
+        }
+        [[fallthrough]];
+      case State::Key:
+        if (c != '"') {
+          fail();
+          return;
+        }
+        beginString(in, pos, true);
+        return;
+      case State::Colon:
+        if (c != ':') {
+          fail();
+          return;
+        }
+        pos++;
+        state = State::Value;
+        return;
+      case State::AfterValue:
+        pos++;
+        if (c == ',') {
+          state = containers.back() == '{' ? State::Key : State::Value;
+        } else {
+          close(c);
+        }
+        return;
+      default:
+        fail();
+    }
+  }
+
+  void beginValue(std::string_view in, size_t& pos) {
+    char c = in[pos];
+    if (c == '{' || c == '[') {
+      pos++;
+      if (containers.size() >= kMaxDepth) {
+        fail();
+        return;
+      }
+      containers.push_back(c);
+      if (c == '{') {
+        state = State::FirstKey;
+        emit(handler.onObjectStart());
+      } else {
+        state = State::FirstElement;
+        emit(handler.onArrayStart());
+      }
+    } else if (c == '"') {
+      beginString(in, pos, false);
+    } else if (isScalarChar(c)) {
+      token.clear();
+      state = State::Scalar;
+    } else {
+      fail();
+    }
+  }
+
+  void close(char c) {
+    char open = c == ']' ? '[' : '{';
+    if ((c != ']' && c != '}') || containers.back() != open) {
+      fail();
+      return;
+    }
+    containers.pop_back();
+    valueDone();
+    emit(c == ']' ? handler.onArrayEnd() : handler.onObjectEnd());
+  }
+
+  // Offset of the closing quote at or after from, or npos if the chunk ends
+  // first. Malformed escapes and control characters are left for
+  // decodeString to reject.
+  size_t findClosingQuote(std::string_view in, size_t from) {
+    size_t p = from;
+    if (pendingEscape) {
+      if (p >= in.size()) {
+        return std::string_view::npos;
+      }
+      pendingEscape = false;
+      p++;
+    }
+    while ((p = findStringSpecial(in, p)) < in.size()) {
+      if (in[p] == '"') {
+        return p;
+      }
+      if (in[p] == '\\') {
+        if (p + 1 >= in.size()) {
+          pendingEscape = true;
+          return std::string_view::npos;
+        }
+        p += 2;
+      } else {
+        p++;
+      }
+    }
+    return std::string_view::npos;
+  }
+
+  void beginString(std::string_view in, size_t& pos, bool isKey) {
+    tokenIsKey = isKey;
+    pendingEscape = false;
+    size_t end = findClosingQuote(in, pos + 1);
+    if (end != std::string_view::npos) {
+      // The whole string is in this chunk: decode it in place.
+      if (!decodeString(in, pos + 1, scratch)) {
+        fail();
+        return;
+      }
+      pos = end + 1;
+      finishString();
+      return;
+    }
+    token.assign(in.substr(pos));
+    pos = in.size();
+    state = State::String;
+  }
+
+  void continueString(std::string_view in, size_t& pos) {
+    size_t end = findClosingQuote(in, pos);
+    if (end == std::string_view::npos) {
+      token.append(in.substr(pos));
+      pos = in.size();
+      return;
+    }
+    token.append(in.substr(pos, end + 1 - pos));
+    pos = end + 1;
+    if (!decodeString(token, 1, scratch)) {
+      fail();
+      return;
+    }
+    finishString();
+  }
+
+  void finishString() {
+    if (tokenIsKey) {
+      state = State::Colon;
+      emit(handler.onKey(scratch));
+    } else {
+      valueDone();
+      emit(handler.onString(scratch));
+    }
+  }
+
+  // Bytes that can appear in a number or a literal.
+  static bool isScalarChar(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' ||
+           c == '+' || c == '.' || c == 'E';
+  }
+
+  void continueScalar(std::string_view in, size_t& pos) {
+    size_t end = pos;
+    while (end < in.size() && isScalarChar(in[end])) {
+      end++;
+    }
+    if (end == in.size()) {
+      token.append(in.substr(pos));
+      pos = end;
+      return;
+    }
+    std::string_view literal;
+    if (token.empty()) {
+      literal = in.substr(pos, end - pos);
+    } else {
+      token.append(in.substr(pos, end - pos));
+      literal = token;
+    }
+    pos = end;
+    finishScalar(literal);
+  }
+
+  void finishScalar(std::string_view literal) {
+    valueDone();
+    if (literal == "true" || literal == "false") {
+      emit(handler.onBool(literal == "true"));
+    } else if (literal == "null") {
+      emit(handler.onNull());
+    } else if (auto number = parseNumber(literal, 0);
+               number && number->end == literal.size()) {
+      emit(std::visit([this](auto v) -> bool { return handler.onNumber(v); },
+                      number->value));
+    } else {
+      fail();
+    }
+  }
+};
+}  // namespace jerry
@@ -0,0 +1,268 @@
+#include "StringDecoder.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "Utf8.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace jerry {
+namespace {
+bool isSpecial(unsigned char c) { return c == '"' || c == '\\' || c < 0x20; }
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Reads the four hex digits of a \u escape starting at pos.
+std::optional<uint32_t> readHex4(std::string_view input, size_t pos) {
+  if (pos + 4 > input.size()) {
+    return std::nullopt;
+  }
+  uint32_t value = 0;
+  for (size_t i = 0; i < 4; i++) {
+    int digit = hexValue(input[pos + i]);
+    if (digit < 0) {
+      return std::nullopt;
+    }
+    value = (value << 4) | static_cast<uint32_t>(digit);
+  }
+  return value;
+}
+
+char* appendUtf8(char* out, uint32_t cp) {
+  if (cp < 0x80) {
+    *out++ = static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    *out++ = static_cast<char>(0xC0 | (cp >> 6));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    *out++ = static_cast<char>(0xE0 | (cp >> 12));
+    *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+  } else {
+    *out++ = static_cast<char>(0xF0 | (cp >> 18));
+    *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  return out;
+}
+
+// Decodes the escape whose backslash is at input[pos]. Writes the decoded
+// bytes to out and returns the offset after the escape.
+std::optional<size_t> decodeEscape(std::string_view input, size_t pos,
+                                   char*& out) {
+  if (pos + 1 >= input.size()) {
+    return std::nullopt;
+  }
+  switch (input[pos + 1]) {
+    case '"':
+      *out++ = '"';
+      return pos + 2;
+    case '\\':
+      *out++ = '\\';
+      return pos + 2;
+    case '/':
+      *out++ = '/';
+      return pos + 2;
+    case 'b':
+      *out++ = '\b';
+      return pos + 2;
+    case 'f':
+      *out++ = '\f';
+      return pos + 2;
+    case 'n':
+      *out++ = '\n';
+      return pos + 2;
+    case 'r':
+      *out++ = '\r';
+      return pos + 2;
+    case 't':
+      *out++ = '\t';
+      return pos + 2;
+    case 'u':
+      break;
+    default:
+      return std::nullopt;
+  }
+
+  auto unit = readHex4(input, pos + 2);
+  if (!unit) {
+    return std::nullopt;
+  }
+  uint32_t cp = *unit;
+  size_t next = pos + 6;
+  if (cp >= 0xDC00 && cp <= 0xDFFF) {
+    // Low surrogate without a preceding high surrogate.
+    return std::nullopt;
+  }
+  if (cp >= 0xD800 && cp <= 0xDBFF) {
+    if (next + 1 >= input.size() || input[next] != '\\' ||
+        input[next + 1] != 'u') {
+      return std::nullopt;
+    }
+    auto low = readHex4(input, next + 2);
+    if (!low || *low < 0xDC00 || *low > 0xDFFF) {
+      return std::nullopt;
+    }
+    cp = 0x10000 + ((cp - 0xD800) << 10) + (*low - 0xDC00);
+    next += 6;
+  }
+  out = appendUtf8(out, cp);
+  return next;
+}
+}  // namespace
+
+size_t findStringSpecial(std::string_view input, size_t pos) noexcept {
+  const char* data = input.data();
+  size_t size = input.size();
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i controlMax = _mm_set1_epi8(0x1F);
+  for (; pos + 16 <= size; pos += 16) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    // Unsigned c <= 0x1F  <=>  max(c, 0x1F) == 0x1F.
+    __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlMax), controlMax));
+    int mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return pos + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+  for (; pos < size; pos++) {
+    if (isSpecial(static_cast<unsigned char>(data[pos]))) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+std::optional<size_t> skipString(std::string_view input,
+                                 size_t pos) noexcept {
+  while (true) {
+    pos = findStringSpecial(input, pos);
+    if (pos >= input.size()) {
+      return std::nullopt;
+    }
+    char c = input[pos];
+    if (c == '"') {
+      return pos + 1;
+    }
+    if (c != '\\' || pos + 1 >= input.size()) {
+      return std::nullopt;
+    }
+    switch (input[pos + 1]) {
+      case '"':
+      case '\\':
+      case '/':
+      case 'b':
+      case 'f':
+      case 'n':
+      case 'r':
+      case 't':
+        pos += 2;
+        break;
+      case 'u': {
+        auto unit = readHex4(input, pos + 2);
+        if (!unit || (*unit >= 0xDC00 && *unit <= 0xDFFF)) {
+          return std::nullopt;
+        }
+        pos += 6;
+        if (*unit >= 0xD800 && *unit <= 0xDBFF) {
+          // A high surrogate must be followed by an escaped low one.
+          if (pos + 1 >= input.size() || input[pos] != '\\' ||
+              input[pos + 1] != 'u') {
+            return std::nullopt;
+          }
+          auto low = readHex4(input, pos + 2);
+          if (!low || *low < 0xDC00 || *low > 0xDFFF) {
+            return std::nullopt;
+          }
+          pos += 6;
+        }
+        break;
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+}
+
+namespace {
+template <typename String>
+std::optional<size_t> decodeInto(std::string_view input, size_t pos,
+                                 String& out, size_t knownValid) {
+  size_t special = findStringSpecial(input, pos);
+  if (special >= input.size()) {
+    return std::nullopt;
+  }
+  if (input[special] == '"') {
+    // Fast path: no escapes at all.
+    if (special > knownValid &&
+        !utf8::isValid(input.substr(pos, special - pos))) {
+      return std::nullopt;
+    }
+    out.assign(input.data() + pos, special - pos);
+    return special + 1;
+  }
+
+  // Escapes are ASCII and decode to whole sequences, so checking the raw
+  // body checks the decoded string.
+  auto end = skipString(input, special);
+  if (!end || (*end - 1 > knownValid &&
+               !utf8::isValid(input.substr(pos, *end - 1 - pos)))) {
+    return std::nullopt;
+  }
+  // Decoding never grows a string, so the raw length is an upper bound.
+  out.resize(*end - 1 - pos);
+  char* write = out.data();
+  while (true) {
+    std::memcpy(write, input.data() + pos, special - pos);
+    write += special - pos;
+    char c = input[special];
+    if (c == '"') {
+      break;
+    }
+    if (c != '\\') {
+      return std::nullopt;
+    }
+    auto next = decodeEscape(input, special, write);
+    if (!next) {
+      return std::nullopt;
+    }
+    pos = *next;
+    special = findStringSpecial(input, pos);
+  }
+  out.resize(static_cast<size_t>(write - out.data()));
+  return special + 1;
+}
+}  // namespace
+
+std::optional<size_t> decodeString(std::string_view input, size_t pos,
+                                   std::string& out, size_t knownValid) {
+  return decodeInto(input, pos, out, knownValid);
+}
+
+std::optional<size_t> decodeString(std::string_view input, size_t pos,
+                                   std::pmr::string& out, size_t knownValid) {
+  return decodeInto(input, pos, out, knownValid);
+}
+}  // namespace jerry
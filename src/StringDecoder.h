@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace jerry {
+/**
+ * @brief Returns the offset of the first `"`, `\` or control character
+ * (< 0x20) at or after pos, or input.size() if there is none.
+ *
+ * Scans 16 bytes at a time with SSE2 where available.
+ */
+size_t findStringSpecial(std::string_view input, size_t pos) noexcept;
+
+/**
+ * @brief Finds the end of a JSON string without decoding it.
+ *
+ * Escape sequences are checked as decodeString would: a known escape
+ * character, four hex digits after `\u`, and surrogates only in high-low
+ * pairs. Raw bytes are not checked for UTF-8.
+ *
+ * @param pos Offset of the first byte after the opening quote.
+ * @return The offset just past the closing quote, or nullopt if the string is
+ * unterminated, contains an unescaped control character or a malformed escape.
+ */
+std::optional<size_t> skipString(std::string_view input, size_t pos) noexcept;
+
+/**
+ * @brief Decodes the body of a JSON string into out.
+ *
+ * Runs without escapes are copied in bulk. The escapes `\" \\ \/ \b \f \n \r
+ * \t` and `\uXXXX` (including surrogate pairs, transcoded to UTF-8) are
+ * decoded. When the string contains escapes, out is sized once up front from
+ * the raw length.
+ *
+ * @param pos Offset of the first byte after the opening quote.
+ * @param out Replaced with the decoded string.
+ * @param knownValid Offset up to which the caller has already found input
+ * to be well-formed UTF-8, e.g. with utf8::findInvalid. A string whose
+ * closing quote is at or before it is not checked again.
+ * @return The offset just past the closing quote, or nullopt if the string is
+ * malformed or not well-formed UTF-8 (see Utf8.h).
+ */
+std::optional<size_t> decodeString(std::string_view input, size_t pos,
+                                   std::string& out, size_t knownValid = 0);
+
+/** As above, decoding into a string that allocates from its own
+ * memory_resource. **/
+std::optional<size_t> decodeString(std::string_view input, size_t pos,
+                                   std::pmr::string& out,
+                                   size_t knownValid = 0);
+}  // namespace jerry
@@ -0,0 +1,261 @@
+#include "StructuralIndex.h"
+
+#include <cstring>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JERRY_X86_64 1
+#include <immintrin.h>
+#endif
+
+namespace jerry {
+namespace {
+constexpr size_t kBlockSize = 64;
+
+// One bit per byte of a 64-byte block.
+struct BlockMasks {
+  uint64_t quote;
+  uint64_t backslash;
+  uint64_t op;
+  uint64_t whitespace;
+};
+
+using Classifier = BlockMasks (*)(const char* block);
+
+BlockMasks classifyScalar(const char* block) {
+  BlockMasks m{0, 0, 0, 0};
+  for (size_t i = 0; i < kBlockSize; i++) {
+    uint64_t bit = uint64_t(1) << i;
+    switch (block[i]) {
+      case '"':
+        m.quote |= bit;
+        break;
+      case '\\':
+        m.backslash |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        m.op |= bit;
+        break;
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        m.whitespace |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+  return m;
+}
+
+#ifdef JERRY_X86_64
+uint64_t eqMask16(const __m128i chunks[4], char c) {
+  const __m128i needle = _mm_set1_epi8(c);
+  uint64_t m = 0;
+  for (int i = 0; i < 4; i++) {
+    uint32_t bits = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], needle)));
+    m |= uint64_t(bits) << (16 * i);
+  }
+  return m;
+}
+
+BlockMasks classifySse2(const char* block) {
+  __m128i chunks[4];
+  for (int i = 0; i < 4; i++) {
+    chunks[i] =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+  }
+  BlockMasks m;
+  m.quote = eqMask16(chunks, '"');
+  m.backslash = eqMask16(chunks, '\\');
+  m.op = eqMask16(chunks, '{') | eqMask16(chunks, '}') |
+         eqMask16(chunks, '[') | eqMask16(chunks, ']') |
+         eqMask16(chunks, ':') | eqMask16(chunks, ',');
+  m.whitespace = eqMask16(chunks, ' ') | eqMask16(chunks, '\t') |
+                 eqMask16(chunks, '\n') | eqMask16(chunks, '\r');
+  return m;
+}
+
+__attribute__((target("avx2"))) uint64_t eqMask32(const __m256i chunks[2],
+                                                  char c) {
+  const __m256i needle = _mm256_set1_epi8(c);
+  uint64_t lo = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[0], needle)));
+  uint64_t hi = static_cast<uint32_t>(
+      _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[1], needle)));
+  return lo | (hi << 32);
+}
+
+__attribute__((target("avx2"))) BlockMasks classifyAvx2(const char* block) {
+  __m256i chunks[2];
+  chunks[0] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  chunks[1] =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+  BlockMasks m;
+  m.quote = eqMask32(chunks, '"');
+  m.backslash = eqMask32(chunks, '\\');
+  m.op = eqMask32(chunks, '{') | eqMask32(chunks, '}') |
+         eqMask32(chunks, '[') | eqMask32(chunks, ']') |
+         eqMask32(chunks, ':') | eqMask32(chunks, ',');
+  m.whitespace = eqMask32(chunks, ' ') | eqMask32(chunks, '\t') |
+                 eqMask32(chunks, '\n') | eqMask32(chunks, '\r');
+  return m;
+}
+#endif
+
+bool supports(StructuralIndex::Implementation impl) {
+  switch (impl) {
+    case StructuralIndex::Implementation::Scalar:
+      return true;
+#ifdef JERRY_X86_64
+    case StructuralIndex::Implementation::SSE2:
+      return true;
+    case StructuralIndex::Implementation::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+Classifier classifierFor(StructuralIndex::Implementation impl) {
+  switch (impl) {
+#ifdef JERRY_X86_64
+    case StructuralIndex::Implementation::SSE2:
+      return classifySse2;
+    case StructuralIndex::Implementation::AVX2:
+      return classifyAvx2;
+#endif
+    default:
+      return classifyScalar;
+  }
+}
+
+// Bit i of the result is the xor of bits 0..i of x.
+uint64_t prefixXor(uint64_t x) {
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+}
+
+// Carried between blocks.
+struct ScanState {
+  // Whether the first byte of the next block is escaped by a backslash.
+  uint64_t escapeCarry = 0;
+  // All ones if the next block starts inside a string.
+  uint64_t inStringCarry = 0;
+  // Whether the last byte of the previous block was part of a scalar.
+  uint64_t scalarCarry = 0;
+};
+
+// Marks the bytes escaped by a backslash. Backslashes are rare outside of
+// escape-heavy strings, so walking the set bits beats a branch-free scheme on
+// typical input.
+uint64_t findEscaped(uint64_t backslash, ScanState& scan) {
+  uint64_t escaped = scan.escapeCarry;
+  scan.escapeCarry = 0;
+  while (backslash) {
+    int i = __builtin_ctzll(backslash);
+    backslash &= backslash - 1;
+    if ((escaped >> i) & 1) {
+      continue;
+    }
+    if (i == 63) {
+      scan.escapeCarry = 1;
+    } else {
+      escaped |= uint64_t(1) << (i + 1);
+    }
+  }
+  return escaped;
+}
+
+uint64_t structuralBits(const BlockMasks& m, ScanState& scan) {
+  uint64_t escaped = findEscaped(m.backslash, scan);
+  uint64_t quotes = m.quote & ~escaped;
+
+  // Bytes from an opening quote up to (not including) its closing quote.
+  uint64_t inString = prefixXor(quotes) ^ scan.inStringCarry;
+  scan.inStringCarry = uint64_t(int64_t(inString) >> 63);
+
+  uint64_t openingQuotes = quotes & inString;
+  uint64_t ops = m.op & ~inString;
+  uint64_t scalar = ~(m.op | m.whitespace | quotes | inString);
+  uint64_t scalarStarts = scalar & ~((scalar << 1) | scan.scalarCarry);
+  scan.scalarCarry = scalar >> 63;
+
+  return openingQuotes | ops | scalarStarts;
+}
+
+void flatten(uint64_t bits, uint32_t base, std::vector<uint32_t>& out) {
+  while (bits) {
+    out.push_back(base + static_cast<uint32_t>(__builtin_ctzll(bits)));
+    bits &= bits - 1;
+  }
+}
+}  // namespace
+
+StructuralIndex::Implementation StructuralIndex::bestImplementation() noexcept {
+  static const Implementation best = [] {
+    if (supports(Implementation::AVX2)) {
+      return Implementation::AVX2;
+    }
+    if (supports(Implementation::SSE2)) {
+      return Implementation::SSE2;
+    }
+    return Implementation::Scalar;
+  }();
+  return best;
+}
+
+std::optional<StructuralIndex> StructuralIndex::build(std::string_view input) {
+  return build(input, bestImplementation());
+}
+
+std::optional<StructuralIndex> StructuralIndex::build(std::string_view input,
+                                                      Implementation impl) {
+  if (input.size() > std::numeric_limits<uint32_t>::max()) {
+    return std::nullopt;
+  }
+  if (!supports(impl)) {
+    impl = Implementation::Scalar;
+  }
+  Classifier classify = classifierFor(impl);
+
+  StructuralIndex index;
+  // Typical JSON has a token start every 4-8 bytes.
+  index.positions.reserve(input.size() / 6 + 8);
+
+  ScanState scan;
+  size_t offset = 0;
+  for (; offset + kBlockSize <= input.size(); offset += kBlockSize) {
+    BlockMasks m = classify(input.data() + offset);
+    flatten(structuralBits(m, scan), static_cast<uint32_t>(offset),
+            index.positions);
+  }
+  if (offset < input.size()) {
+    // Pad the tail with whitespace so it never produces tokens.
+    char tail[kBlockSize];
+    std::memset(tail, ' ', kBlockSize);
+    std::memcpy(tail, input.data() + offset, input.size() - offset);
+    BlockMasks m = classify(tail);
+    flatten(structuralBits(m, scan), static_cast<uint32_t>(offset),
+            index.positions);
+  }
+
+  if (scan.inStringCarry) {
+    return std::nullopt;
+  }
+  return index;
+}
+}  // namespace jerry
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace jerry {
+/**
+ * @brief Offsets of every token start in a JSON document.
+ *
+ * Built in one pass over the input, 64 bytes at a time (in the style of
+ * simdjson's stage 1). The index holds, in increasing order, the offset of:
+ *  - every structural character `{ } [ ] : ,` outside of a string,
+ *  - every opening `"` of a string,
+ *  - the first byte of every other run of non-whitespace bytes outside of a
+ *    string (numbers, true, false, null, or garbage).
+ *
+ * Escaped quotes are handled, so a `"` preceded by an odd number of
+ * backslashes never starts or ends a string. The index only locates tokens;
+ * it does not validate them.
+ */
+class StructuralIndex {
+public:
+  enum class Implementation { Scalar, SSE2, AVX2 };
+
+  /**
+   * @brief Builds the index with the best implementation for this CPU.
+   *
+   * @return nullopt if the input ends inside a string or is too large to be
+   * addressed by 32-bit offsets.
+   */
+  static std::optional<StructuralIndex> build(std::string_view input);
+
+  /** Builds the index with a specific implementation (falls back to Scalar
+   * if it is not supported on this CPU). **/
+  static std::optional<StructuralIndex> build(std::string_view input,
+                                              Implementation impl);
+
+  /** The implementation build(input) dispatches to at runtime. **/
+  static Implementation bestImplementation() noexcept;
+
+  size_t size() const noexcept { return positions.size(); }
+  bool empty() const noexcept { return positions.empty(); }
+  uint32_t operator[](size_t i) const noexcept { return positions[i]; }
+  const std::vector<uint32_t>& getPositions() const noexcept {
+    return positions;
+  }
+
+private:
+  std::vector<uint32_t> positions;
+};
+}  // namespace jerry
@@ -0,0 +1,305 @@
+#include "Tape.h"
+
+#include <bit>
+
+#include "Reader.h"
+#include "StringDecoder.h"
+
+namespace jerry {
+namespace {
+uint64_t makeEntry(TapeType type, uint64_t payload = 0) {
+  return (static_cast<uint64_t>(type) << Tape::kTypeShift) |
+         (payload & Tape::kPayloadMask);
+}
+}  // namespace
+
+// Appends entries as the Reader walks the input. Strings are recorded by
+// position, never decoded.
+class TapeBuilder {
+public:
+  explicit TapeBuilder(Tape& tape) : tape(tape) {}
+
+  bool beginArray() { return open(TapeType::ArrayStart); }
+  bool beginObject() { return open(TapeType::ObjectStart); }
+  bool endArray(size_t) { return close(TapeType::ArrayEnd); }
+  bool endObject(size_t) { return close(TapeType::ObjectEnd); }
+
+  bool rawKey(size_t begin, size_t end, bool escaped) {
+    return rawString(begin, end, escaped);
+  }
+
+  bool rawString(size_t begin, size_t end, bool escaped) {
+    tape.entries.push_back(makeEntry(TapeType::String, begin));
+    tape.entries.push_back((end - begin) | (escaped ? Tape::kEscapedBit : 0));
+    return true;
+  }
+
+  bool number(const ParsedNumber& n, std::string_view) {
+    if (auto i = std::get_if<int64_t>(&n.value)) {
+      tape.entries.push_back(makeEntry(TapeType::Integer));
+      tape.entries.push_back(static_cast<uint64_t>(*i));
+    } else {
+      tape.entries.push_back(makeEntry(TapeType::Double));
+      tape.entries.push_back(std::bit_cast<uint64_t>(std::get<double>(n.value)));
+    }
+    return true;
+  }
+
+  bool boolean(bool b) {
+    tape.entries.push_back(makeEntry(b ? TapeType::True : TapeType::False));
+    return true;
+  }
+
+  bool null() {
+    tape.entries.push_back(makeEntry(TapeType::Null));
+    return true;
+  }
+
+private:
+  Tape& tape;
+  std::vector<size_t> openContainers;
+
+  bool open(TapeType type) {
+    openContainers.push_back(tape.entries.size());
+    tape.entries.push_back(makeEntry(type));
+    return true;
+  }
+
+  bool close(TapeType type) {
+    size_t start = openContainers.back();
+    openContainers.pop_back();
+    size_t end = tape.entries.size();
+    tape.entries[start] = makeEntry(typeOf(start), end);
+    tape.entries.push_back(makeEntry(type, start));
+    return true;
+  }
+
+  TapeType typeOf(size_t i) const { return Tape::typeOf(tape.entries[i]); }
+};
+
+std::optional<Tape> Tape::fromString(std::string_view input) {
+  Tape tape;
+  tape.source = input;
+  // Roughly one token per 6 bytes, 1-2 entries per token.
+  tape.entries.reserve(input.size() / 4 + 4);
+  TapeBuilder builder(tape);
+  detail::Reader<TapeBuilder> reader(input, builder);
+  if (!reader.parseDocument()) {
+    return std::nullopt;
+  }
+  return tape;
+}
+
+std::optional<Tape> Tape::fromFile(const std::string& path) {
+  auto file = MappedFile::open(path);
+  if (!file) {
+    return std::nullopt;
+  }
+  auto mapping = std::make_shared<const MappedFile>(std::move(*file));
+  auto tape = fromString(mapping->view());
+  if (tape) {
+    tape->file = std::move(mapping);
+  }
+  return tape;
+}
+
+Tape::Ref Tape::root() const { return Ref(this, 0); }
+
+std::optional<bool> Tape::Ref::getBool() const {
+  if (!isBool()) {
+    return std::nullopt;
+  }
+  return type() == TapeType::True;
+}
+
+std::optional<int64_t> Tape::Ref::getInt64() const {
+  if (!valid() || type() != TapeType::Integer) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(tape->entries[index + 1]);
+}
+
+std::optional<double> Tape::Ref::getDouble() const {
+  if (!valid()) {
+    return std::nullopt;
+  }
+  if (type() == TapeType::Double) {
+    return std::bit_cast<double>(tape->entries[index + 1]);
+  }
+  if (type() == TapeType::Integer) {
+    return static_cast<double>(static_cast<int64_t>(tape->entries[index + 1]));
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string_view> Tape::Ref::getRawString() const {
+  if (!isString()) {
+    return std::nullopt;
+  }
+  size_t begin = payloadOf(entry());
+  size_t length = tape->entries[index + 1] & ~kEscapedBit;
+  return tape->source.substr(begin, length);
+}
+
+bool Tape::Ref::hasEscapes() const {
+  return isString() && (tape->entries[index + 1] & kEscapedBit) != 0;
+}
+
+std::optional<std::string> Tape::Ref::getString() const {
+  auto raw = getRawString();
+  if (!raw) {
+    return std::nullopt;
+  }
+  if (!hasEscapes()) {
+    return std::string(*raw);
+  }
+  // The Reader checked every string's UTF-8 before the tape was built.
+  std::string decoded;
+  if (!decodeString(tape->source, payloadOf(entry()), decoded,
+                    tape->source.size())) {
+    return std::nullopt;
+  }
+  return decoded;
+}
+
+size_t Tape::Ref::skip() const {
+  switch (type()) {
+    case TapeType::ObjectStart:
+    case TapeType::ArrayStart:
+      return payloadOf(entry()) + 1;
+    case TapeType::String:
+    case TapeType::Integer:
+    case TapeType::Double:
+      return index + 2;
+    default:
+      return index + 1;
+  }
+}
+
+Tape::Ref Tape::Ref::firstChild() const {
+  if (!isArray() && !isObject()) {
+    return Ref();
+  }
+  if (payloadOf(entry()) == index + 1) {
+    return Ref();
+  }
+  return Ref(tape, index + 1);
+}
+
+Tape::Ref Tape::Ref::nextSibling() const {
+  if (!valid()) {
+    return Ref();
+  }
+  size_t next = skip();
+  if (next >= tape->entries.size()) {
+    return Ref();
+  }
+  TapeType t = typeOf(tape->entries[next]);
+  if (t == TapeType::ArrayEnd || t == TapeType::ObjectEnd) {
+    return Ref();
+  }
+  return Ref(tape, next);
+}
+
+size_t Tape::Ref::size() const {
+  size_t count = 0;
+  if (isArray()) {
+    for (auto e = firstChild(); e; e = e.nextSibling()) {
+      count++;
+    }
+  } else if (isObject()) {
+    for (auto k = firstChild(); k; k = k.value().nextSibling()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+Tape::Ref Tape::Ref::operator[](size_t i) const {
+  if (!isArray()) {
+    return Ref();
+  }
+  auto e = firstChild();
+  for (; e && i > 0; i--) {
+    e = e.nextSibling();
+  }
+  return e;
+}
+
+Tape::Ref Tape::Ref::operator[](std::string_view key) const {
+  if (!isObject()) {
+    return Ref();
+  }
+  for (auto k = firstChild(); k; k = k.value().nextSibling()) {
+    if (!k.hasEscapes() ? k.getRawString() == key : k.getString() == key) {
+      return k.value();
+    }
+  }
+  return Ref();
+}
+
+namespace {
+// Fills out with a copy of ref's subtree. Returns false if a string in it
+// fails to decode.
+bool buildJsonValue(const Tape::Ref& ref, JsonValue& out) {
+  switch (ref.type()) {
+    case TapeType::Null:
+      out.value = std::monostate();
+      return true;
+    case TapeType::True:
+      out.value = true;
+      return true;
+    case TapeType::False:
+      out.value = false;
+      return true;
+    case TapeType::Integer:
+      out.value = *ref.getInt64();
+      return true;
+    case TapeType::Double:
+      out.value = *ref.getDouble();
+      return true;
+    case TapeType::String: {
+      auto s = ref.getString();
+      if (!s) {
+        return false;
+      }
+      out.value = std::move(*s);
+      return true;
+    }
+    case TapeType::ArrayStart: {
+      std::vector<JsonValue> values;
+      for (auto e = ref.firstChild(); e; e = e.nextSibling()) {
+        if (!buildJsonValue(e, values.emplace_back())) {
+          return false;
+        }
+      }
+      out.value = std::move(values);
+      return true;
+    }
+    case TapeType::ObjectStart: {
+      JsonObject members;
+      for (auto k = ref.firstChild(); k; k = k.value().nextSibling()) {
+        auto key = k.getString();
+        JsonValue member;
+        if (!key || !buildJsonValue(k.value(), member)) {
+          return false;
+        }
+        members.insert_or_assign(std::move(*key), std::move(member));
+      }
+      out.value = std::move(members);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+}  // namespace
+
+std::optional<JsonValue> Tape::Ref::toJsonValue() const {
+  JsonValue value;
+  if (!valid() || !buildJsonValue(*this, value)) {
+    return std::nullopt;
+  }
+  return value;
+}
+}  // namespace jerry
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Json.h"
+#include "MappedFile.h"
+
+namespace jerry {
+enum class TapeType : uint8_t {
+  ObjectStart,
+  ObjectEnd,
+  ArrayStart,
+  ArrayEnd,
+  String,
+  Integer,
+  Double,
+  True,
+  False,
+  Null
+};
+
+/**
+ * @brief A parsed document laid out as one flat array of 64-bit entries.
+ *
+ * Each entry holds a TapeType in its top 8 bits and a 56-bit payload:
+ *  - ObjectStart/ArrayStart: index of the matching end entry, so a whole
+ *    subtree is skipped in O(1).
+ *  - ObjectEnd/ArrayEnd: index of the matching start entry.
+ *  - String: offset of the string body in the source. The next entry holds
+ *    its raw length, with the top bit set if it contains escapes.
+ *  - Integer/Double: unused. The next entry holds the value's bits.
+ *  - True/False/Null: unused.
+ *
+ * Object members are stored as a String key entry followed by the value.
+ * Strings are not copied: the Tape refers to the source buffer, which must
+ * outlive it. Escaped strings are decoded on access.
+ */
+class Tape {
+public:
+  static std::optional<Tape> fromString(std::string_view input);
+  /** Parses a memory-mapped file. The Tape keeps the mapping alive, so raw
+   * strings point straight into the file. **/
+  static std::optional<Tape> fromFile(const std::string& path);
+
+  class Ref;
+  Ref root() const;
+
+  const std::vector<uint64_t>& getEntries() const noexcept { return entries; }
+  std::string_view getSource() const noexcept { return source; }
+
+  static constexpr int kTypeShift = 56;
+  static constexpr uint64_t kPayloadMask = (uint64_t(1) << kTypeShift) - 1;
+  static constexpr uint64_t kEscapedBit = uint64_t(1) << 63;
+
+  static TapeType typeOf(uint64_t entry) {
+    return static_cast<TapeType>(entry >> kTypeShift);
+  }
+  static uint64_t payloadOf(uint64_t entry) { return entry & kPayloadMask; }
+
+  /**
+   * @brief Read-only cursor to one value on a Tape.
+   *
+   * Navigation never decodes or allocates; only getString() on an escaped
+   * string and toJsonValue() do.
+   */
+  class Ref {
+  public:
+    Ref() : tape(nullptr), index(0) {}
+    Ref(const Tape* tape, size_t index) : tape(tape), index(index) {}
+
+    bool valid() const noexcept { return tape != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    TapeType type() const { return typeOf(entry()); }
+    size_t getIndex() const noexcept { return index; }
+
+    bool isNull() const { return valid() && type() == TapeType::Null; }
+    bool isBool() const {
+      return valid() && (type() == TapeType::True || type() == TapeType::False);
+    }
+    bool isNumber() const {
+      return valid() &&
+             (type() == TapeType::Integer || type() == TapeType::Double);
+    }
+    bool isString() const { return valid() && type() == TapeType::String; }
+    bool isArray() const { return valid() && type() == TapeType::ArrayStart; }
+    bool isObject() const {
+      return valid() && type() == TapeType::ObjectStart;
+    }
+
+    std::optional<bool> getBool() const;
+    std::optional<int64_t> getInt64() const;
+    std::optional<double> getDouble() const;
+    /** The decoded string. **/
+    std::optional<std::string> getString() const;
+    /** The string body exactly as it appears in the source. Equal to the
+     * decoded string when hasEscapes() is false. **/
+    std::optional<std::string_view> getRawString() const;
+    bool hasEscapes() const;
+
+    /** Index of the entry after this value: O(1) even for containers. **/
+    size_t skip() const;
+
+    /** First element of an array, or first key of an object. **/
+    Ref firstChild() const;
+    /** The entry after this value in its container, or an invalid Ref at
+     * the container's end. Members alternate key, value, key, value:
+     *
+     *   for (auto k = obj.firstChild(); k; k = k.value().nextSibling())
+     **/
+    Ref nextSibling() const;
+    /** The value associated with an object key. **/
+    Ref value() const { return Ref(tape, skip()); }
+
+    size_t size() const;
+    Ref operator[](size_t i) const;
+    Ref operator[](std::string_view key) const;
+
+    /** A copy of this subtree, or nullopt if a string in it fails to
+     * decode. **/
+    std::optional<JsonValue> toJsonValue() const;
+
+  private:
+    const Tape* tape;
+    size_t index;
+
+    uint64_t entry() const { return tape->entries[index]; }
+  };
+
+private:
+  std::vector<uint64_t> entries;
+  std::string_view source;
+  // Set by fromFile; source views it. Shared so that copies of the Tape stay
+  // valid.
+  std::shared_ptr<const MappedFile> file;
+
+  friend class TapeBuilder;
+};
+}  // namespace jerry
@@ -0,0 +1,101 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace jerry {
+namespace {
+// The pool and deque index of the worker running on this thread, if any.
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (size_t i = 0; i < threads; i++) {
+    queues.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back([this, i] { run(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleepMutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  size_t index = currentPool == this
+                     ? currentIndex
+                     : nextQueue.fetch_add(1, std::memory_order_relaxed) %
+                           queues.size();
+  {
+    // Counting under sleepMutex means a worker cannot miss the wakeup, and
+    // holding the deque's lock means no one pops the task before it counts.
+    std::lock_guard sleepLock(sleepMutex);
+    std::lock_guard lock(queues[index]->mutex);
+    queues[index]->tasks.push_back(std::move(task));
+    pending++;
+  }
+  wake.notify_one();
+}
+
+bool ThreadPool::runPendingTask() {
+  std::function<void()> task;
+  if (!tryPop(currentPool == this ? currentIndex : 0, task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+bool ThreadPool::tryPop(size_t index, std::function<void()>& task) {
+  {
+    Queue& own = *queues[index];
+    std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      pending--;
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues.size(); i++) {
+    Queue& victim = *queues[(index + i) % queues.size()];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      pending--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::run(size_t index) {
+  currentPool = this;
+  currentIndex = index;
+  std::function<void()> task;
+  while (true) {
+    if (tryPop(index, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock lock(sleepMutex);
+    wake.wait(lock, [&] { return stopping || pending > 0; });
+    if (stopping && pending == 0) {
+      return;
+    }
+  }
+}
+}  // namespace jerry
@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace jerry {
+/**
+ * @brief A fixed-size pool of threads with one task deque per worker.
+ *
+ * Each worker pops from the back of its own deque and, when that is empty,
+ * steals from the front of the others. Tasks submitted from inside a worker
+ * go to that worker's deque, so related work tends to stay on one core;
+ * tasks submitted from outside are spread round-robin.
+ *
+ * Destroying the pool runs every task already submitted, then joins.
+ */
+class ThreadPool {
+public:
+  /** threads == 0 uses std::thread::hardware_concurrency(). **/
+  explicit ThreadPool(size_t threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void submit(std::function<void()> task);
+
+  /** Runs one queued task on the calling thread, if any is waiting. A
+   * thread that blocks on work it submitted can call this in a loop so
+   * that the work still progresses when every worker is busy, or when the
+   * caller is itself the pool's only worker. **/
+  bool runPendingTask();
+
+  size_t size() const noexcept { return workers.size(); }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<size_t> nextQueue{0};
+  // Tasks sitting in a deque, not yet picked up.
+  std::atomic<size_t> pending{0};
+  std::mutex sleepMutex;
+  std::condition_variable wake;
+  bool stopping = false;
+
+  void run(size_t index);
+  bool tryPop(size_t index, std::function<void()>& task);
+};
+
+/**
+ * @brief A blocking FIFO that holds at most `capacity` items.
+ *
+ * push() waits while the queue is full and pop() while it is empty. After
+ * close(), push() drops its item and pop() drains what is left, then
+ * returns nullopt.
+ */
+template <typename T> class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+  void push(T item) {
+    std::unique_lock lock(mutex);
+    notFull.wait(lock, [&] { return closed || items.size() < capacity; });
+    if (closed) {
+      return;
+    }
+    items.push_back(std::move(item));
+    notEmpty.notify_one();
+  }
+
+  std::optional<T> pop() {
+    std::unique_lock lock(mutex);
+    notEmpty.wait(lock, [&] { return closed || !items.empty(); });
+    if (items.empty()) {
+      return std::nullopt;
+    }
+    T item = std::move(items.front());
+    items.pop_front();
+    notFull.notify_one();
+    return item;
+  }
+
+  void close() {
+    std::lock_guard lock(mutex);
+    closed = true;
+    notFull.notify_all();
+    notEmpty.notify_all();
+  }
+
+private:
+  size_t capacity;
+  std::deque<T> items;
+  std::mutex mutex;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+  bool closed = false;
+};
+}  // namespace jerry
@@ -1,29 +1,90 @@
 #pragma once
 #include <cassert>
+#include <concepts>
 #include <cstddef>
 #include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "JsonToken.h"
+#include "NumberParser.h"
+#include "Stats.h"
+#include "StringDecoder.h"
 
 namespace jerry {
+/**
+ * @brief A cursor over an input buffer.
+ *
+ * TokenizerState does not own the input; it is a view plus a position, so
+ * copying, advancing and backtracking are all O(1). The caller (or the Json
+ * entry point) must keep the underlying buffer alive for as long as any state
+ * derived from it is in use.
+ */
 class TokenizerState {
 private:
-  std::string input;
+  std::string_view input;
   size_t position;
 
 public:
-  explicit TokenizerState(std::string s, size_t pos);
-  static TokenizerState init(std::string s, size_t pos);
-  char currentCharacter() const noexcept;
-  size_t getPosition() const noexcept;
-  std::string getInputString() const noexcept { return input; }
+  explicit TokenizerState(std::string_view s, size_t pos) noexcept
+      : input(s), position(pos) {}
+#if JERRY_STATS
+  // Counted copies; without JERRY_STATS the type stays trivially copyable.
+  TokenizerState(const TokenizerState& other) noexcept
+      : input(other.input), position(other.position) {
+    detail::recordStateCopy();
+  }
+  TokenizerState& operator=(const TokenizerState& other) noexcept {
+    input = other.input;
+    position = other.position;
+    detail::recordStateCopy();
+    return *this;
+  }
+#endif
+  static TokenizerState init(std::string_view s, size_t pos);
+  char currentCharacter() const noexcept { return input[position]; }
+  size_t getPosition() const noexcept { return position; }
+  std::string_view getInputString() const noexcept { return input; }
   size_t getInputStringSize() const noexcept { return input.size(); }
-  TokenizerState advance() const;
+  bool atEnd() const noexcept { return position >= input.size(); }
+  TokenizerState advance(size_t count = 1) const noexcept {
+    return TokenizerState(input, position + count);
+  }
 };
 
+template <typename T>
+using TokenizerResult = std::optional<std::pair<T, TokenizerState>>;
+
+namespace detail {
+// Whether std::function has to heap-allocate to hold an F: the standard
+// libraries keep small, trivially copyable callables in an inline buffer of
+// about two pointers.
+template <typename F>
+inline constexpr bool erasureAllocates =
+    sizeof(F) > 2 * sizeof(void*) || !std::is_trivially_copyable_v<F>;
+
+// Wraps f so that every run is counted under kind (see Stats.h). Returns f
+// itself when JERRY_STATS is off.
+template <typename T, typename F> auto instrument(Combinator kind, F f) {
+  if constexpr (kStatsEnabled) {
+    return [kind, f = std::move(f)](TokenizerState state)
+               -> TokenizerResult<T> {
+      auto result = f(state);
+      recordRun(kind, result.has_value(),
+                result ? result->second.getPosition() - state.getPosition()
+                       : 0);
+      return result;
+    };
+  } else {
+    return f;
+  }
+}
+}  // namespace detail
+
 template <typename T> class Tokenizer {
 private:
   // Used during bind operations.
@@ -33,8 +94,11 @@ private:
   TokenizerFunc func;
 
 public:
+  using value_type = T;
+
   explicit Tokenizer(TokenizerFunc f) : func(f) {
     assert(this->func != nullptr);
+    detail::recordClosure();
   };
 
   static Tokenizer<T> init(TokenizerFunc f) {
@@ -45,6 +109,13 @@ public:
   std::optional<std::pair<T, TokenizerState>> run(TokenizerState s) const {
     // The TokenizerFunc passes it's execution result back up the stack.
     // TokenizerFunc == std::optional<std::pair<T, TokenizerState>>
+    if constexpr (kStatsEnabled) {
+      auto result = this->func(s);
+      detail::recordRun(Combinator::Erased, result.has_value(),
+                        result ? result->second.getPosition() - s.getPosition()
+                               : 0);
+      return result;
+    }
     return this->func(s);
   }
 
@@ -65,9 +136,9 @@ public:
   Tokenizer<U> bind(std::function<Tokenizer<U>(T)> f) const {
     TokenizerFunc currentFunc = func;
     auto transform = f;
-    return Tokenizer<U>([currentFunc = std::move(currentFunc),
-                         transform = std::move(transform)](TokenizerState state)
-                            -> std::optional<std::pair<U, TokenizerState>> {
+    auto bound = [currentFunc = std::move(currentFunc),
+                  transform = std::move(transform)](TokenizerState state)
+        -> std::optional<std::pair<U, TokenizerState>> {
       auto result = currentFunc(state);
       if (!result) {
         return std::nullopt;
@@ -77,8 +148,17 @@ public:
       TokenizerState newState = result->second;
 
       Tokenizer<U> newTokenizer = transform(val);
-      return newTokenizer.run(newState);
-    });
+      auto next = newTokenizer.run(newState);
+      if (!next) {
+        detail::recordBacktrack(Combinator::Bind,
+                                newState.getPosition() - state.getPosition());
+      }
+      return next;
+    };
+    if constexpr (detail::erasureAllocates<decltype(bound)>) {
+      detail::recordAllocation();
+    }
+    return Tokenizer<U>(std::move(bound));
   }
 
   /**
@@ -91,16 +171,20 @@ public:
    * function.
    */
   template <typename U> Tokenizer<U> map(std::function<U(T)> f) const {
-    return Tokenizer<U>([currentFunc = std::move(func),
-                         transform = std::move(f)](TokenizerState state)
-                            -> std::optional<std::pair<U, TokenizerState>> {
+    auto mapped = [currentFunc = std::move(func),
+                   transform = std::move(f)](TokenizerState state)
+        -> std::optional<std::pair<U, TokenizerState>> {
       auto result = currentFunc(state);
       if (!result) {
         return std::nullopt;
       }
       U transformation = transform(result->first);
       return std::make_pair(transformation, result->second);
-    });
+    };
+    if constexpr (detail::erasureAllocates<decltype(mapped)>) {
+      detail::recordAllocation();
+    }
+    return Tokenizer<U>(std::move(mapped));
   }
 };
 
@@ -127,6 +211,7 @@ static Tokenizer<T> orElse(Tokenizer<T> x, Tokenizer<T> y) {
     if (r) {
       return std::make_pair(r->first, r->second);
     }
+    detail::recordBacktrack(Combinator::OrElse, 0);
     r = y.run(state);
     if (r) {
       return std::make_pair(r->first, r->second);
@@ -169,290 +254,462 @@ template <typename T> static Tokenizer<std::vector<T>> manyOf(Tokenizer<T> x) {
       });
 }
 
+/**
+ * @brief Anything that can be run like a Tokenizer.
+ *
+ * Satisfied by both the type-erased Tokenizer<T> and StaticTokenizer<T, F>.
+ */
+template <typename P>
+concept TokenizerLike = requires(const P& p, TokenizerState s) {
+  typename P::value_type;
+  { p.run(s) } -> std::convertible_to<TokenizerResult<typename P::value_type>>;
+};
+
+/**
+ * @brief A Tokenizer whose function type is part of its type.
+ *
+ * Tokenizer<T> hides its function behind std::function, so every combinator
+ * adds a heap-allocated closure and an indirect call. StaticTokenizer keeps
+ * the concrete callable instead: bind, map, orElse and manyOf produce nested
+ * closure types that the compiler can see through and inline into a single
+ * loop. Use erase() (or the implicit conversion) wherever a uniform
+ * Tokenizer<T> is needed, e.g. to store grammars in containers or to recurse.
+ *
+ * @tparam T The type of the value produced.
+ * @tparam F A callable TokenizerState -> TokenizerResult<T>.
+ */
+template <typename T, typename F> class StaticTokenizer {
+private:
+  F func;
+
+public:
+  using value_type = T;
+
+  explicit StaticTokenizer(F f) : func(std::move(f)) {
+    detail::recordClosure();
+  }
+
+  TokenizerResult<T> run(TokenizerState s) const { return func(s); }
+
+  /**
+   * @brief Static counterpart of Tokenizer<T>::bind.
+   *
+   * @tparam U Optional result type. When omitted it is deduced from the
+   * tokenizer returned by f.
+   * @param f A function that takes a value of type T and returns any
+   * TokenizerLike.
+   */
+  template <typename U = void, typename G> auto bind(G f) const {
+    using Next = std::invoke_result_t<const G&, T>;
+    using V = std::conditional_t<std::is_void_v<U>, typename Next::value_type,
+                                 U>;
+    auto bound = [current = func, transform = std::move(f)](
+                     TokenizerState state) -> TokenizerResult<V> {
+      auto result = current(state);
+      if (!result) {
+        return std::nullopt;
+      }
+      auto next = transform(std::move(result->first)).run(result->second);
+      if (!next) {
+        detail::recordBacktrack(
+            Combinator::Bind,
+            result->second.getPosition() - state.getPosition());
+      }
+      return next;
+    };
+    auto counted = detail::instrument<V>(Combinator::Bind, std::move(bound));
+    return StaticTokenizer<V, decltype(counted)>(std::move(counted));
+  }
+
+  /**
+   * @brief Static counterpart of Tokenizer<T>::map.
+   *
+   * @tparam U Optional result type. When omitted it is deduced from f.
+   */
+  template <typename U = void, typename G> auto map(G f) const {
+    using V = std::conditional_t<std::is_void_v<U>,
+                                 std::invoke_result_t<const G&, T>, U>;
+    auto mapped = [current = func, transform = std::move(f)](
+                      TokenizerState state) -> TokenizerResult<V> {
+      auto result = current(state);
+      if (!result) {
+        return std::nullopt;
+      }
+      return std::make_pair(V(transform(std::move(result->first))),
+                            result->second);
+    };
+    auto counted = detail::instrument<V>(Combinator::Map, std::move(mapped));
+    return StaticTokenizer<V, decltype(counted)>(std::move(counted));
+  }
+
+  /** Wraps the tokenizer in a type-erased Tokenizer<T>. **/
+  Tokenizer<T> erase() const {
+    if constexpr (detail::erasureAllocates<F>) {
+      detail::recordAllocation();
+    }
+    return Tokenizer<T>(func);
+  }
+
+  operator Tokenizer<T>() const { return erase(); }
+};
+
+/** Builds a StaticTokenizer<T> from a TokenizerState -> TokenizerResult<T>
+ * callable, counted under kind when JERRY_STATS is on. **/
+template <typename T, typename F>
+static auto makeTokenizer(Combinator kind, F f) {
+  auto counted = detail::instrument<T>(kind, std::move(f));
+  return StaticTokenizer<T, decltype(counted)>(std::move(counted));
+}
+
+/** Builds a StaticTokenizer<T> from a TokenizerState -> TokenizerResult<T>
+ * callable. **/
+template <typename T, typename F> static auto makeTokenizer(F f) {
+  return makeTokenizer<T>(Combinator::Custom, std::move(f));
+}
+
+/**
+ * @brief Static counterpart of orElse(Tokenizer<T>, Tokenizer<T>).
+ *
+ * Selected whenever either argument is a StaticTokenizer; the erased overload
+ * above still wins when both arguments are Tokenizer<T>.
+ */
+template <TokenizerLike X, TokenizerLike Y>
+static auto orElse(X x, Y y) {
+  using T = typename X::value_type;
+  return makeTokenizer<T>(
+      Combinator::OrElse,
+      [x = std::move(x), y = std::move(y)](
+          TokenizerState state) -> TokenizerResult<T> {
+        if (auto r = x.run(state)) {
+          return r;
+        }
+        detail::recordBacktrack(Combinator::OrElse, 0);
+        return y.run(state);
+      });
+}
+
+/**
+ * @brief Static counterpart of manyOf(Tokenizer<T>).
+ *
+ * NEVER returns nullopt. Just consumes if it can.
+ */
+template <TokenizerLike X> static auto manyOf(X x) {
+  using T = typename X::value_type;
+  return makeTokenizer<std::vector<T>>(
+      Combinator::ManyOf,
+      [x = std::move(x)](TokenizerState state)
+          -> TokenizerResult<std::vector<T>> {
+        std::vector<T> gotTokens;
+        while (!state.atEnd()) {
+          auto r = x.run(state);
+          if (!r) {
+            break;
+          }
+          if constexpr (kStatsEnabled) {
+            if (gotTokens.size() == gotTokens.capacity()) {
+              detail::recordAllocation();
+            }
+          }
+          gotTokens.push_back(std::move(r->first));
+          state = r->second;
+        }
+        return std::make_pair(std::move(gotTokens), state);
+      });
+}
+
+/**
+ * @brief Like manyOf, but discards the matches instead of collecting them.
+ *
+ * Produces the number of matches. Useful for whitespace and other input that
+ * only needs to be consumed. NEVER returns nullopt.
+ */
+template <TokenizerLike X> static auto skipMany(X x) {
+  return makeTokenizer<size_t>(
+      Combinator::SkipMany,
+      [x = std::move(x)](TokenizerState state) -> TokenizerResult<size_t> {
+        size_t count = 0;
+        while (!state.atEnd()) {
+          auto r = x.run(state);
+          if (!r) {
+            break;
+          }
+          state = r->second;
+          count++;
+        }
+        return std::make_pair(count, state);
+      });
+}
+
+namespace detail {
+// pure() and fail() share this callable so that both arms of
+// `cond ? fail<T>() : pure(v)` have the same static type.
+template <typename T> struct Constant {
+  std::optional<T> value;
+
+  TokenizerResult<T> operator()(TokenizerState state) const {
+    recordRun(Combinator::Constant, value.has_value(), 0);
+    if (!value) {
+      return std::nullopt;
+    }
+    return std::make_pair(*value, state);
+  }
+};
+}  // namespace detail
+
 // Generators for different token types
 
 /** Returns the same state **/
-template <typename T> static Tokenizer<T> pure(T value) {
-  return Tokenizer<T>([value = std::move(value)](TokenizerState state)
-                          -> std::optional<std::pair<T, TokenizerState>> {
-    return std::make_pair(value, state);
-  });
+template <typename T> static auto pure(T value) {
+  return StaticTokenizer<T, detail::Constant<T>>(
+      detail::Constant<T>{std::move(value)});
 }
 
 /** Returns the same state **/
-template <typename T>
-static Tokenizer<T> match(T value, std::function<bool(T)> matcher) {
-  return Tokenizer<T>(
-      [matcher = std::move(matcher), value = std::move(value)](
-          TokenizerState state) -> std::optional<std::pair<T, TokenizerState>> {
-        if (matcher(value)) {
-          return pure<T>(value).run(state);
-        }
-        return std::nullopt;
-      });
+template <typename T> static auto fail() {
+  return StaticTokenizer<T, detail::Constant<T>>(
+      detail::Constant<T>{std::nullopt});
+}
+
+/** Returns the same state **/
+template <typename T, typename M> static auto match(T value, M matcher) {
+  return matcher(value) ? pure<T>(std::move(value)) : fail<T>();
 }
 
-template <typename T> static Tokenizer<T> isEqual(T value, T other) {
-  auto equalityChecker = [other = std::move(other)](T val) {
+template <typename T> static auto isEqual(T value, T other) {
+  return match<T>(std::move(value), [&other](const T& val) {
     return val == other;
-  };
-  return match<T>(value, equalityChecker);
+  });
 }
 
-template <typename T> static Tokenizer<T> isNotEqual(T value, T other) {
-  auto equalityChecker = [other = std::move(other)](T val) {
+template <typename T> static auto isNotEqual(T value, T other) {
+  return match<T>(std::move(value), [&other](const T& val) {
     return val != other;
-  };
-  return match<T>(value, equalityChecker);
+  });
 }
 
-static Tokenizer<char> isDigit(char c) {
+static auto isDigit(char c) {
   auto digitChecker = [](char c) { return c >= '0' && c <= '9'; };
   return match<char>(c, digitChecker);
 }
 
-/** Returns the same state **/
-template <typename T> static Tokenizer<T> fail() {
-  return Tokenizer<T>(
-      [](TokenizerState) -> std::optional<std::pair<T, TokenizerState>> {
-        return std::nullopt;
+static auto character() {
+  return makeTokenizer<char>(
+      Combinator::Character,
+      [](TokenizerState state) -> TokenizerResult<char> {
+        if (state.atEnd()) {
+          return std::nullopt;
+        }
+        char val = state.currentCharacter();
+        return std::make_pair(val, state.advance());
       });
 }
 
-static Tokenizer<char> character() {
-  return Tokenizer<char>([](TokenizerState state)
-                             -> std::optional<std::pair<char, TokenizerState>> {
-    if (state.getPosition() >= state.getInputStringSize()) {
-      return std::nullopt;
-    }
-    char val = state.currentCharacter();
-    return std::make_pair(val, state.advance());
-  });
-}
-
-static Tokenizer<char> expectChar(char expected) {
-  return Tokenizer<char>([expected = std::move(expected)](TokenizerState state)
-                             -> std::optional<std::pair<char, TokenizerState>> {
-    if (state.getPosition() >= state.getInputStringSize() ||
-        state.currentCharacter() != expected) {
-      return std::nullopt;
-    }
-    return std::make_pair(expected, state.advance());
-  });
+static auto expectChar(char expected) {
+  return makeTokenizer<char>(
+      Combinator::ExpectChar,
+      [expected](TokenizerState state) -> TokenizerResult<char> {
+        if (state.atEnd() || state.currentCharacter() != expected) {
+          return std::nullopt;
+        }
+        return std::make_pair(expected, state.advance());
+      });
 }
 
-static Tokenizer<std::string> expectString(std::string expected) {
-  return Tokenizer<std::string>(
+static auto expectString(std::string expected) {
+  return makeTokenizer<std::string>(
+      Combinator::ExpectString,
       [expected = std::move(expected)](TokenizerState state)
-          -> std::optional<std::pair<std::string, TokenizerState>> {
-        for (size_t i = 0; i < expected.size(); i++) {
-          auto r = expectChar(expected[i]).run(state);
-          if (!r) {
-            return std::nullopt;
+          -> TokenizerResult<std::string> {
+        auto rest = state.getInputString().substr(state.getPosition());
+        if (!rest.starts_with(expected)) {
+          return std::nullopt;
+        }
+        if constexpr (kStatsEnabled) {
+          if (expected.size() > std::string().capacity()) {
+            detail::recordAllocation();
           }
-          state = r->second;
         }
-        return std::make_pair(expected, state);
+        return std::make_pair(expected, state.advance(expected.size()));
       });
 }
 
 [[maybe_unused]]
-static Tokenizer<uint> digit() {
+static auto digit() {
   auto asDigit = [](char c) { return static_cast<uint>(c - '0'); };
 
   return character().bind<uint>(
       [asDigit](char c) { return isDigit(c).map<uint>(asDigit); });
 }
 
-static Tokenizer<char> whitespace() { return expectChar(' '); }
+/** One byte of RFC 8259 whitespace: space, tab, line feed or carriage
+ * return. **/
+static auto whitespace() {
+  return makeTokenizer<char>(
+      Combinator::ExpectChar,
+      [](TokenizerState state) -> TokenizerResult<char> {
+        if (state.atEnd()) {
+          return std::nullopt;
+        }
+        char c = state.currentCharacter();
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+          return std::nullopt;
+        }
+        return std::make_pair(c, state.advance());
+      });
+}
 
 [[maybe_unused]]
-static Tokenizer<char> braceOpen() {
+static auto braceOpen() {
   return expectChar('{');
 }
 
 [[maybe_unused]]
-static Tokenizer<char> braceClose() {
+static auto braceClose() {
   return expectChar('}');
 }
 
 [[maybe_unused]]
-static Tokenizer<char> bracketOpen() {
+static auto bracketOpen() {
   return expectChar('[');
 }
 
 [[maybe_unused]]
-static Tokenizer<char> bracketClose() {
+static auto bracketClose() {
   return expectChar(']');
 }
 
 [[maybe_unused]]
-static Tokenizer<char> colon() {
+static auto colon() {
   return expectChar(':');
 }
 
 [[maybe_unused]]
-static Tokenizer<char> negative() {
+static auto negative() {
   return expectChar('-');
 }
 
 [[maybe_unused]]
-static Tokenizer<char> doubleQuote() {
+static auto doubleQuote() {
   return expectChar('"');
 }
 
 [[maybe_unused]]
-static Tokenizer<JsonToken> jsonNull() {
-  return expectString("null").map<JsonToken>([](std::string) {
+static auto jsonNull() {
+  return expectString("null").map<JsonToken>([](const std::string&) {
     return JsonToken::makeStructural(JsonTokenType::Null);
   });
 }
 
 [[maybe_unused]]
-static Tokenizer<JsonToken> boolean() {
+static auto boolean() {
   return orElse(expectString("true"), expectString("false"))
-      .map<JsonToken>([](std::string s) -> JsonToken {
-        if (s == "true") {
-          return JsonToken::fromBool(true);
-        }
-        else if (s == "false") {
-          return JsonToken::fromBool(false);
-        }
-        // This should never happen but we need to return something
-        return JsonToken::makeNull();
+      .map<JsonToken>([](const std::string& s) -> JsonToken {
+        return JsonToken::fromBool(s == "true");
       });
 }
 
-static Tokenizer<std::string> word() {
-  return manyOf<char>(character().bind<char>([](char c) {
+static auto word() {
+  return manyOf(character().bind<char>([](char c) {
            return (c == ' ' || c == '\t' || c == '\n') ? fail<char>() : pure(c);
          }))
-      .bind<std::string>([](std::vector<char> chars) {
-        return pure(std::string(chars.begin(), chars.end()));
+      .map<std::string>([](const std::vector<char>& chars) {
+        return std::string(chars.begin(), chars.end());
       });
 }
 
 // Consumes word+whitespace sequences until position >= input.size()
 [[maybe_unused]]
-static Tokenizer<std::vector<std::string>> sentence() {
+static auto sentence() {
   auto wordFollowedBySpace = word().bind<std::string>([](std::string w) {
-    return manyOf<char>(whitespace()).map<std::string>([w](std::vector<char>) {
-      return w;
-    });
+    return skipMany(whitespace()).map<std::string>(
+        [w = std::move(w)](size_t) { return w; });
   });
-  return manyOf<std::string>(wordFollowedBySpace);
+  return manyOf(wordFollowedBySpace);
 }
 
-[[maybe_unused]]
-static Tokenizer<JsonToken> objectStart() {
-  return character().bind<JsonToken>([](char c) {
-    return isEqual(c, '{').bind<JsonToken>([](char) {
-      return pure(JsonToken::makeStructural(JsonTokenType::ObjectStart));
-    });
-  });
+// Matches a single structural character and produces its token.
+static auto structural(char c, JsonTokenType type) {
+  return expectChar(c).map<JsonToken>(
+      [type](char) { return JsonToken::makeStructural(type); });
 }
 
 [[maybe_unused]]
-static Tokenizer<JsonToken> objectEnd() {
-  return character().bind<JsonToken>([](char c) {
-    return isEqual(c, '}').bind<JsonToken>([](char) {
-      return pure(JsonToken::makeStructural(JsonTokenType::ObjectEnd));
-    });
-  });
+static auto objectStart() {
+  return structural('{', JsonTokenType::ObjectStart);
 }
 
 [[maybe_unused]]
-static Tokenizer<JsonToken> arrayStart() {
-  return character().bind<JsonToken>([](char c) {
-    return isEqual(c, '[').bind<JsonToken>([](char) {
-      return pure(JsonToken::makeStructural(JsonTokenType::ArrayStart));
-    });
-  });
+static auto objectEnd() {
+  return structural('}', JsonTokenType::ObjectEnd);
 }
 
 [[maybe_unused]]
-static Tokenizer<JsonToken> comma() {
-  return character().bind<JsonToken>([](char c) {
-    return isEqual(c, ',').bind<JsonToken>([](char) {
-      return pure(JsonToken::makeStructural(JsonTokenType::Comma));
-    });
-  });
+static auto arrayStart() {
+  return structural('[', JsonTokenType::ArrayStart);
 }
 
-
 [[maybe_unused]]
-static Tokenizer<JsonToken> arrayEnd() {
-  return character().bind<JsonToken>([](char c) {
-    return isEqual(c, ']').bind<JsonToken>([](char) {
-      return pure(JsonToken::makeStructural(JsonTokenType::ArrayEnd));
-    });
-  });
+static auto comma() {
+  return structural(',', JsonTokenType::Comma);
 }
 
 [[maybe_unused]]
-static Tokenizer<JsonToken> jsonString() {
-  return doubleQuote()
-      .bind<std::string>([](char) {
-        return manyOf<char>(character().bind<char>([](char c) {
-                 return c == '"' ? fail<char>() : pure(c);
-               }))
-            .bind<std::string>([](std::vector<char> chars) {
-              return doubleQuote().map<std::string>(
-                  [chars = std::move(chars)](char) {
-                    std::string s(chars.begin(), chars.end());
-                    return s;
-                  });
-            });
-      })
-      .map<JsonToken>([](std::string s) { return JsonToken::fromString(s); });
-}
-
-// TODO implement negatives and exponents
-[[maybe_unused]]
-static Tokenizer<JsonToken> jsonNumber() {
-  return Tokenizer<JsonToken>(
-      [](TokenizerState state)
-          -> std::optional<std::pair<JsonToken, TokenizerState>> {
-        auto negativeResult = negative().run(state);
-        bool isNegative = false;
-        if (negativeResult) {
-          state = negativeResult->second;
-          isNegative = true;
-        }
+static auto arrayEnd() {
+  return structural(']', JsonTokenType::ArrayEnd);
+}
 
-        auto r = manyOf<uint>(digit()).run(state);
-        if (!r || r->first.size() == 0) {
+/**
+ * @brief Parses a JSON string literal, decoding escape sequences.
+ *
+ * Scans for the closing quote 16 bytes at a time and copies runs without
+ * escapes in bulk (see StringDecoder.h).
+ */
+[[maybe_unused]]
+static auto jsonString() {
+  return makeTokenizer<JsonToken>(
+      Combinator::JsonString,
+      [](TokenizerState state) -> TokenizerResult<JsonToken> {
+        if (state.atEnd() || state.currentCharacter() != '"') {
           return std::nullopt;
         }
-        state = r->second;
-        auto digits = r->first;
-        double number = 0;
-        for (int digit : digits) {
-          number = number * 10 + digit;
+        std::string s;
+        auto end =
+            decodeString(state.getInputString(), state.getPosition() + 1, s);
+        if (!end) {
+          return std::nullopt;
         }
-        if (isNegative) {
-          number *= -1;
+        if constexpr (kStatsEnabled) {
+          if (s.capacity() > std::string().capacity()) {
+            detail::recordAllocation();
+          }
         }
+        return std::make_pair(JsonToken::fromString(std::move(s)),
+                              state.advance(*end - state.getPosition()));
+      });
+}
 
-        // Check for decimal point then get rest of number
-        r = expectChar('.')
-                .bind<std::vector<uint>>(
-                    [](char) { return manyOf<uint>(digit()); })
-                .run(state);
-
-        if (!r) {
-          return std::make_pair(JsonToken::fromNumber(number), state);
+/**
+ * @brief Parses a JSON number.
+ *
+ * Produces an exact int64_t token for integers that fit, and a correctly
+ * rounded double otherwise (see NumberParser.h).
+ */
+[[maybe_unused]]
+static auto jsonNumber() {
+  return makeTokenizer<JsonToken>(
+      Combinator::JsonNumber,
+      [](TokenizerState state) -> TokenizerResult<JsonToken> {
+        auto number = parseNumber(state.getInputString(), state.getPosition());
+        if (!number) {
+          return std::nullopt;
         }
-        state = r->second;
-
-        digits = r->first;
-        double fraction = 0;
-        double divisor = 10;
-        for (int digit : digits) {
-          fraction += digit / divisor;
-          divisor *= 10;
+        auto next = state.advance(number->end - state.getPosition());
+        if (std::holds_alternative<int64_t>(number->value)) {
+          return std::make_pair(
+              JsonToken::fromInteger(std::get<int64_t>(number->value)), next);
         }
-        return std::make_pair(JsonToken::fromNumber(number + fraction), state);
+        return std::make_pair(
+            JsonToken::fromNumber(std::get<double>(number->value)), next);
       });
 }
 } // namespace jerry
@@ -0,0 +1,395 @@
+#include "Utf8.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JERRY_X86_64 1
+#include <immintrin.h>
+#endif
+
+namespace jerry::utf8 {
+namespace {
+constexpr size_t kBlockSize = 64;
+
+// One sequence read by the scalar decoder: its length when valid, otherwise
+// the length of its maximal ill-formed subpart.
+struct Sequence {
+  size_t length;
+  bool valid;
+};
+
+// Reads the sequence starting at data[0] (of which size bytes remain) by the
+// ranges of Unicode's Table 3-7.
+Sequence readSequence(const unsigned char* data, size_t size) {
+  unsigned char lead = data[0];
+  if (lead < 0x80) {
+    return {1, true};
+  }
+  size_t continuations;
+  unsigned char low = 0x80;
+  unsigned char high = 0xBF;
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    continuations = 1;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    continuations = 2;
+    low = lead == 0xE0 ? 0xA0 : 0x80;
+    high = lead == 0xED ? 0x9F : 0xBF;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    continuations = 3;
+    low = lead == 0xF0 ? 0x90 : 0x80;
+    high = lead == 0xF4 ? 0x8F : 0xBF;
+  } else {
+    return {1, false};
+  }
+  for (size_t i = 1; i <= continuations; i++) {
+    if (i >= size || data[i] < low || data[i] > high) {
+      return {i, false};
+    }
+    low = 0x80;
+    high = 0xBF;
+  }
+  return {continuations + 1, true};
+}
+
+size_t findInvalidScalar(std::string_view input, size_t pos) {
+  auto data = reinterpret_cast<const unsigned char*>(input.data());
+  size_t size = input.size();
+  while (pos < size) {
+    if (data[pos] < 0x80) {
+      pos++;
+      continue;
+    }
+    Sequence s = readSequence(data + pos, size - pos);
+    if (!s.valid) {
+      return pos;
+    }
+    pos += s.length;
+  }
+  return size;
+}
+
+// A block scanner checks input 64 bytes at a time and returns input.size()
+// if it is well-formed, otherwise the offset of the first block holding an
+// error. Every sequence before that offset is well-formed except one that
+// may run into it.
+using BlockScanner = size_t (*)(std::string_view input);
+
+size_t scanBlocksScalar(std::string_view) { return 0; }
+
+#ifdef JERRY_X86_64
+// Error classes of the lookup algorithm (Keiser and Lemire, "Validating
+// UTF-8 In Less Than One Instruction Per Byte"). A byte pair is an error
+// when the classes looked up from the high nibble of the first byte, the
+// low nibble of the first byte and the high nibble of the second all share
+// a bit. Bit 7 marks two continuations in a row, which is only an error
+// when the second is not the third or fourth byte of a sequence.
+constexpr uint8_t kTooShort = 1 << 0;
+constexpr uint8_t kTooLong = 1 << 1;
+constexpr uint8_t kOverlong3 = 1 << 2;
+constexpr uint8_t kTooLarge = 1 << 3;
+constexpr uint8_t kSurrogate = 1 << 4;
+constexpr uint8_t kOverlong2 = 1 << 5;
+constexpr uint8_t kTooLarge1000 = 1 << 6;
+constexpr uint8_t kOverlong4 = 1 << 6;
+constexpr uint8_t kTwoConts = 1 << 7;
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+constexpr uint8_t kByte1High[16] = {
+    // 0_______: ASCII
+    kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+    kTooLong,
+    // 10______: continuation
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    // 1100____, 1101____: two-byte lead
+    kTooShort | kOverlong2, kTooShort,
+    // 1110____: three-byte lead
+    kTooShort | kOverlong3 | kSurrogate,
+    // 1111____: four-byte lead
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4};
+
+constexpr uint8_t kByte1Low[16] = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000};
+
+constexpr uint8_t kByte2High[16] = {
+    // 0_______: ASCII
+    kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooShort, kTooShort,
+    // 1000____
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 |
+        kOverlong4,
+    // 1001____
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    // 101_____
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    // 11______: lead
+    kTooShort, kTooShort, kTooShort, kTooShort};
+
+__attribute__((target("ssse3"))) __m128i table16(const uint8_t (&t)[16]) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(t));
+}
+
+// The errors of the 16 bytes of input, given the 16 before them.
+__attribute__((target("ssse3"))) __m128i errors16(__m128i input,
+                                                 __m128i prev) {
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+  __m128i prev1 = _mm_alignr_epi8(input, prev, 15);
+  __m128i byte1High = _mm_shuffle_epi8(
+      table16(kByte1High), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  __m128i byte1Low =
+      _mm_shuffle_epi8(table16(kByte1Low), _mm_and_si128(prev1, nibble));
+  __m128i byte2High = _mm_shuffle_epi8(
+      table16(kByte2High), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+  __m128i special =
+      _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+  // Continuations owed to a three- or four-byte lead two or three back.
+  __m128i third = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 14),
+                                _mm_set1_epi8(char(0xE0 - 0x80)));
+  __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(input, prev, 13),
+                                 _mm_set1_epi8(char(0xF0 - 0x80)));
+  __m128i owed = _mm_and_si128(_mm_or_si128(third, fourth),
+                               _mm_set1_epi8(char(0x80)));
+  return _mm_xor_si128(owed, special);
+}
+
+// Nonzero if the chunk ends inside a sequence.
+__attribute__((target("ssse3"))) __m128i incomplete16(__m128i input) {
+  const __m128i max = _mm_setr_epi8(
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xFF), char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+  return _mm_subs_epu8(input, max);
+}
+
+// The block of input at pos, or the tail from pos copied into a block of
+// zeros, which as ASCII make a sequence left open at the end an error.
+const char* blockAt(std::string_view input, size_t pos,
+                    char (&padded)[kBlockSize]) {
+  if (pos + kBlockSize <= input.size()) {
+    return input.data() + pos;
+  }
+  std::memset(padded, 0, kBlockSize);
+  std::memcpy(padded, input.data() + pos, input.size() - pos);
+  return padded;
+}
+
+__attribute__((target("ssse3"))) size_t scanBlocksSsse3(
+    std::string_view input) {
+  char padded[kBlockSize];
+  __m128i prev = _mm_setzero_si128();
+  __m128i pending = _mm_setzero_si128();
+  for (size_t pos = 0; pos < input.size(); pos += kBlockSize) {
+    const char* block = blockAt(input, pos, padded);
+    __m128i chunks[4];
+    for (int i = 0; i < 4; i++) {
+      chunks[i] =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+    }
+    __m128i any = _mm_or_si128(_mm_or_si128(chunks[0], chunks[1]),
+                               _mm_or_si128(chunks[2], chunks[3]));
+    // A sequence left open by the previous block is an error only if this
+    // block is all ASCII; otherwise errors16 checks its continuations.
+    __m128i error = pending;
+    if (_mm_movemask_epi8(any) != 0) {
+      error = errors16(chunks[0], prev);
+      for (int i = 1; i < 4; i++) {
+        error = _mm_or_si128(error, errors16(chunks[i], chunks[i - 1]));
+      }
+      pending = incomplete16(chunks[3]);
+    } else {
+      pending = _mm_setzero_si128();
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) !=
+        0xFFFF) {
+      return pos;
+    }
+    prev = chunks[3];
+  }
+  // Only a last block that was not padded can leave a sequence open.
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(pending, _mm_setzero_si128())) !=
+      0xFFFF) {
+    return input.size() - kBlockSize;
+  }
+  return input.size();
+}
+
+__attribute__((target("avx2"))) __m256i table32(const uint8_t (&t)[16]) {
+  return _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(t)));
+}
+
+// input shifted right by N bytes, with the last N bytes of prev shifted in.
+template <int N>
+__attribute__((target("avx2"))) __m256i previous32(__m256i input,
+                                                   __m256i prev) {
+  return _mm256_alignr_epi8(
+      input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+__attribute__((target("avx2"))) __m256i errors32(__m256i input,
+                                                 __m256i prev) {
+  const __m256i nibble = _mm256_set1_epi8(0x0F);
+  __m256i prev1 = previous32<1>(input, prev);
+  __m256i byte1High = _mm256_shuffle_epi8(
+      table32(kByte1High),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+  __m256i byte1Low = _mm256_shuffle_epi8(table32(kByte1Low),
+                                         _mm256_and_si256(prev1, nibble));
+  __m256i byte2High = _mm256_shuffle_epi8(
+      table32(kByte2High),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+  __m256i special =
+      _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+  __m256i third = _mm256_subs_epu8(previous32<2>(input, prev),
+                                   _mm256_set1_epi8(char(0xE0 - 0x80)));
+  __m256i fourth = _mm256_subs_epu8(previous32<3>(input, prev),
+                                    _mm256_set1_epi8(char(0xF0 - 0x80)));
+  __m256i owed = _mm256_and_si256(_mm256_or_si256(third, fourth),
+                                  _mm256_set1_epi8(char(0x80)));
+  return _mm256_xor_si256(owed, special);
+}
+
+__attribute__((target("avx2"))) __m256i incomplete32(__m256i input) {
+  const __m256i max = _mm256_setr_epi8(
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xFF), char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+      char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1));
+  return _mm256_subs_epu8(input, max);
+}
+
+__attribute__((target("avx2"))) size_t scanBlocksAvx2(
+    std::string_view input) {
+  char padded[kBlockSize];
+  __m256i prev = _mm256_setzero_si256();
+  __m256i pending = _mm256_setzero_si256();
+  for (size_t pos = 0; pos < input.size(); pos += kBlockSize) {
+    const char* block = blockAt(input, pos, padded);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i hi =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+    __m256i error = pending;
+    if (_mm256_movemask_epi8(_mm256_or_si256(lo, hi)) != 0) {
+      error = _mm256_or_si256(errors32(lo, prev), errors32(hi, lo));
+      pending = incomplete32(hi);
+    } else {
+      pending = _mm256_setzero_si256();
+    }
+    if (!_mm256_testz_si256(error, error)) {
+      return pos;
+    }
+    prev = hi;
+  }
+  if (!_mm256_testz_si256(pending, pending)) {
+    return input.size() - kBlockSize;
+  }
+  return input.size();
+}
+#endif
+
+bool supports(Implementation impl) {
+  switch (impl) {
+    case Implementation::Scalar:
+      return true;
+#ifdef JERRY_X86_64
+    case Implementation::SSSE3:
+      return __builtin_cpu_supports("ssse3");
+    case Implementation::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+BlockScanner scannerFor(Implementation impl) {
+  switch (impl) {
+#ifdef JERRY_X86_64
+    case Implementation::SSSE3:
+      return scanBlocksSsse3;
+    case Implementation::AVX2:
+      return scanBlocksAvx2;
+#endif
+    default:
+      return scanBlocksScalar;
+  }
+}
+
+size_t findInvalidWith(std::string_view input, BlockScanner scan) {
+  size_t pos = scan(input);
+  if (pos == input.size()) {
+    return pos;
+  }
+  // Back up over at most three continuations to the lead of a sequence that
+  // may run into the failed block.
+  for (size_t back = 0; back < 4 && pos > 0; back++) {
+    if ((static_cast<unsigned char>(input[pos - 1]) & 0xC0) != 0x80) {
+      pos--;
+      break;
+    }
+    pos--;
+  }
+  return findInvalidScalar(input, pos);
+}
+}  // namespace
+
+Implementation bestImplementation() noexcept {
+  static const Implementation best = [] {
+    if (supports(Implementation::AVX2)) {
+      return Implementation::AVX2;
+    }
+    if (supports(Implementation::SSSE3)) {
+      return Implementation::SSSE3;
+    }
+    return Implementation::Scalar;
+  }();
+  return best;
+}
+
+size_t findInvalid(std::string_view input) noexcept {
+  static const BlockScanner scan = scannerFor(bestImplementation());
+  return findInvalidWith(input, scan);
+}
+
+size_t findInvalid(std::string_view input, Implementation impl) noexcept {
+  if (!supports(impl)) {
+    impl = Implementation::Scalar;
+  }
+  return findInvalidWith(input, scannerFor(impl));
+}
+
+std::string replaceInvalid(std::string_view input) {
+  auto data = reinterpret_cast<const unsigned char*>(input.data());
+  std::string out;
+  out.reserve(input.size());
+  size_t pos = 0;
+  while (true) {
+    size_t bad = findInvalid(input.substr(pos)) + pos;
+    out.append(input.substr(pos, bad - pos));
+    if (bad == input.size()) {
+      return out;
+    }
+    out += "\xEF\xBF\xBD";
+    pos = bad + readSequence(data + bad, input.size() - bad).length;
+  }
+}
+}  // namespace jerry::utf8
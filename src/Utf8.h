@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace jerry::utf8 {
+enum class Implementation { Scalar, SSSE3, AVX2 };
+
+/** The implementation findInvalid(input) dispatches to at runtime. **/
+Implementation bestImplementation() noexcept;
+
+/**
+ * @brief Offset of the first byte of the first ill-formed sequence, or
+ * input.size() if input is well-formed UTF-8.
+ *
+ * Well-formed means Unicode's Table 3-7: no overlong encodings, no
+ * surrogates, nothing above U+10FFFF and no truncated sequence at the end.
+ * Input is checked 64 bytes at a time with the lookup-table algorithm of
+ * Keiser and Lemire, using the widest of AVX2 and SSSE3 the CPU supports;
+ * only a block found to hold an error is rescanned byte by byte.
+ *
+ * Parsers that see the whole input (Reader::parseDocument, validate) call
+ * this once up front instead of checking each string: one pass is cheaper,
+ * and a byte >= 0x80 outside a string is a syntax error anyway, so the
+ * result only matters when it falls inside a string.
+ */
+size_t findInvalid(std::string_view input) noexcept;
+
+/** As above with a specific implementation (falls back to Scalar if it is
+ * not supported on this CPU). **/
+size_t findInvalid(std::string_view input, Implementation impl) noexcept;
+
+/**
+ * @brief True if input is well-formed UTF-8.
+ *
+ * Inline so that the strings of a document, which are mostly short and
+ * ASCII, are checked 8 bytes at a time without a call; only a string with a
+ * byte >= 0x80 goes on to findInvalid.
+ */
+inline bool isValid(std::string_view input) noexcept {
+  const char* data = input.data();
+  size_t size = input.size();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    if ((word & 0x8080808080808080) != 0) {
+      return findInvalid(input.substr(i)) == size - i;
+    }
+  }
+  for (; i < size; i++) {
+    if (static_cast<unsigned char>(data[i]) >= 0x80) {
+      return findInvalid(input.substr(i)) == size - i;
+    }
+  }
+  return true;
+}
+
+/** What a parser does with strings that are not well-formed UTF-8. **/
+enum class Policy {
+  /** Fail the parse. **/
+  Reject,
+  /** Replace each ill-formed sequence with U+FFFD (see replaceInvalid). **/
+  Replace
+};
+
+/**
+ * @brief A copy of input with each maximal ill-formed subpart replaced by
+ * U+FFFD, as Unicode recommends (section 3.9).
+ *
+ * Ill-formed subparts consist only of bytes >= 0x80, so the JSON structure
+ * of the input is unchanged.
+ */
+std::string replaceInvalid(std::string_view input);
+}  // namespace jerry::utf8
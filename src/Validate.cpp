@@ -0,0 +1,399 @@
+#include "Validate.h"
+
+#include <bitset>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <system_error>
+
+#include "Skip.h"
+#include "StringDecoder.h"
+#include "Utf8.h"
+
+namespace jerry {
+namespace {
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool isHex(char c) {
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+class Validator {
+public:
+  explicit Validator(std::string_view input)
+      : input(input), invalidUtf8(utf8::findInvalid(input)) {}
+
+  ValidationResult run() {
+    pos = skipSpaces(0);
+    Next next = Next::Value;
+    while (true) {
+      switch (next) {
+        case Next::Value:
+          if (!value(next)) {
+            return {error, pos};
+          }
+          break;
+        case Next::Key:
+          if (!key()) {
+            return {error, pos};
+          }
+          next = Next::Value;
+          break;
+        case Next::AfterValue:
+          if (depth == 0) {
+            pos = skipSpaces(pos);
+            if (pos != input.size()) {
+              return {ValidationError::TrailingContent, pos};
+            }
+            return {ValidationError::None, pos};
+          }
+          if (!afterValue(next)) {
+            return {error, pos};
+          }
+          break;
+      }
+    }
+  }
+
+private:
+  enum class Next { Value, Key, AfterValue };
+
+  std::string_view input;
+  // Offset of the first ill-formed UTF-8 byte in input, found up front (see
+  // utf8::findInvalid).
+  size_t invalidUtf8;
+  size_t pos = 0;
+  ValidationError error = ValidationError::None;
+  // Bit d is set when the container open at depth d is an object.
+  std::bitset<kMaxValidationDepth> objects;
+  size_t depth = 0;
+
+  bool fail(ValidationError e) {
+    error = e;
+    return false;
+  }
+
+  bool end() const { return pos >= input.size(); }
+
+  // Compact input rarely has whitespace between tokens, so look at the next
+  // byte before calling out to skipWhitespace.
+  size_t skipSpaces(size_t from) const {
+    if (from < input.size() && static_cast<unsigned char>(input[from]) > ' ') {
+      return from;
+    }
+    return skipWhitespace(input, from);
+  }
+
+  // Reads the value at pos. A scalar is consumed whole; a container is
+  // opened, and next says what its first member or element starts with.
+  bool value(Next& next) {
+    if (end()) {
+      return fail(ValidationError::UnexpectedEnd);
+    }
+    next = Next::AfterValue;
+    switch (input[pos]) {
+      case '{':
+      case '[': {
+        bool object = input[pos] == '{';
+        if (depth == kMaxValidationDepth) {
+          return fail(ValidationError::TooDeep);
+        }
+        objects[depth++] = object;
+        pos = skipSpaces(pos + 1);
+        if (!end() && input[pos] == (object ? '}' : ']')) {
+          pos++;
+          depth--;
+          return true;
+        }
+        next = object ? Next::Key : Next::Value;
+        return true;
+      }
+      case '"':
+        return string();
+      case 't':
+        return literal("true");
+      case 'f':
+        return literal("false");
+      case 'n':
+        return literal("null");
+      default:
+        if (input[pos] == '-' || isDigit(input[pos])) {
+          return number();
+        }
+        return fail(ValidationError::UnexpectedCharacter);
+    }
+  }
+
+  // Reads a key, the colon after it and the whitespace before the value.
+  bool key() {
+    if (end()) {
+      return fail(ValidationError::UnexpectedEnd);
+    }
+    if (input[pos] != '"') {
+      return fail(ValidationError::UnexpectedCharacter);
+    }
+    if (!string()) {
+      return false;
+    }
+    pos = skipSpaces(pos);
+    if (end()) {
+      return fail(ValidationError::UnexpectedEnd);
+    }
+    if (input[pos] != ':') {
+      return fail(ValidationError::UnexpectedCharacter);
+    }
+    pos = skipSpaces(pos + 1);
+    return true;
+  }
+
+  // Reads the comma or closing bracket after a member or element.
+  bool afterValue(Next& next) {
+    pos = skipSpaces(pos);
+    if (end()) {
+      return fail(ValidationError::UnexpectedEnd);
+    }
+    bool object = objects[depth - 1];
+    if (input[pos] == ',') {
+      pos = skipSpaces(pos + 1);
+      next = object ? Next::Key : Next::Value;
+      return true;
+    }
+    if (input[pos] != (object ? '}' : ']')) {
+      return fail(ValidationError::UnexpectedCharacter);
+    }
+    pos++;
+    depth--;
+    next = Next::AfterValue;
+    return true;
+  }
+
+  bool literal(std::string_view word) {
+    if (input.size() - pos >= word.size() &&
+        std::memcmp(input.data() + pos, word.data(), word.size()) == 0) {
+      pos += word.size();
+      return true;
+    }
+    for (size_t i = 0; i < word.size(); i++, pos++) {
+      if (end()) {
+        return fail(ValidationError::UnexpectedEnd);
+      }
+      if (input[pos] != word[i]) {
+        return fail(ValidationError::InvalidLiteral);
+      }
+    }
+    return true;
+  }
+
+  // The string whose opening quote is at pos.
+  bool string() {
+    pos++;
+    while (true) {
+      pos = findStringSpecial(input, pos);
+      if (invalidUtf8 < pos) {
+        pos = invalidUtf8;
+        return fail(ValidationError::InvalidUtf8);
+      }
+      if (end()) {
+        return fail(ValidationError::UnexpectedEnd);
+      }
+      char c = input[pos];
+      if (c == '"') {
+        pos++;
+        return true;
+      }
+      if (c != '\\') {
+        return fail(ValidationError::ControlCharacter);
+      }
+      if (!escape()) {
+        return false;
+      }
+    }
+  }
+
+  // The escape whose backslash is at pos.
+  bool escape() {
+    if (pos + 1 >= input.size()) {
+      pos = input.size();
+      return fail(ValidationError::UnexpectedEnd);
+    }
+    switch (input[pos + 1]) {
+      case '"':
+      case '\\':
+      case '/':
+      case 'b':
+      case 'f':
+      case 'n':
+      case 'r':
+      case 't':
+        pos += 2;
+        return true;
+      case 'u':
+        break;
+      default:
+        return fail(ValidationError::InvalidEscape);
+    }
+    uint32_t unit = 0;
+    if (!hex4(pos + 2, unit)) {
+      return false;
+    }
+    if (unit >= 0xDC00 && unit <= 0xDFFF) {
+      return fail(ValidationError::InvalidEscape);
+    }
+    if (unit < 0xD800 || unit > 0xDBFF) {
+      pos += 6;
+      return true;
+    }
+    // A high surrogate must be followed by an escaped low surrogate.
+    size_t low = pos + 6;
+    if (low + 1 >= input.size() || input[low] != '\\' ||
+        input[low + 1] != 'u') {
+      return fail(ValidationError::InvalidEscape);
+    }
+    uint32_t second = 0;
+    if (!hex4(low + 2, second)) {
+      return false;
+    }
+    if (second < 0xDC00 || second > 0xDFFF) {
+      return fail(ValidationError::InvalidEscape);
+    }
+    pos = low + 6;
+    return true;
+  }
+
+  // The four hex digits at from. On failure pos is left at the escape.
+  bool hex4(size_t from, uint32_t& unit) {
+    for (size_t i = from; i < from + 4; i++) {
+      if (i >= input.size()) {
+        pos = input.size();
+        return fail(ValidationError::UnexpectedEnd);
+      }
+      if (!isHex(input[i])) {
+        return fail(ValidationError::InvalidEscape);
+      }
+      char c = input[i];
+      int digit = isDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+      unit = (unit << 4) | static_cast<uint32_t>(digit);
+    }
+    return true;
+  }
+
+  // Consumes digits, eight at a time while they last, returning how many.
+  size_t digits() {
+    size_t start = pos;
+    while (input.size() - pos >= 8) {
+      uint64_t chunk;
+      std::memcpy(&chunk, input.data() + pos, sizeof(chunk));
+      // Each byte is a digit iff its high nibble is 3 and adding 6 to it
+      // does not carry into the high nibble.
+      if (((chunk & 0xF0F0F0F0F0F0F0F0) |
+           (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) !=
+          0x3333333333333333) {
+        break;
+      }
+      pos += 8;
+    }
+    while (!end() && isDigit(input[pos])) {
+      pos++;
+    }
+    return pos - start;
+  }
+
+  bool number() {
+    size_t start = pos;
+    if (input[pos] == '-') {
+      pos++;
+    }
+    if (end()) {
+      return fail(ValidationError::UnexpectedEnd);
+    }
+    if (!isDigit(input[pos])) {
+      return fail(ValidationError::InvalidNumber);
+    }
+    // Where the first significant digit sits relative to the decimal point,
+    // so that 10^(magnitude - 1) <= |value| < 10^magnitude unless the value
+    // is zero.
+    int64_t magnitude = 0;
+    bool zero = input[pos] == '0';
+    if (zero) {
+      pos++;
+    } else {
+      magnitude = static_cast<int64_t>(digits());
+    }
+    if (!end() && input[pos] == '.') {
+      pos++;
+      size_t fraction = pos;
+      if (digits() == 0) {
+        return fail(end() ? ValidationError::UnexpectedEnd
+                          : ValidationError::InvalidNumber);
+      }
+      if (zero) {
+        size_t first = fraction;
+        while (first < pos && input[first] == '0') {
+          first++;
+        }
+        zero = first == pos;
+        magnitude = -static_cast<int64_t>(first - fraction);
+      }
+    }
+    int64_t exponent = 0;
+    if (!end() && (input[pos] == 'e' || input[pos] == 'E')) {
+      pos++;
+      bool negative = false;
+      if (!end() && (input[pos] == '+' || input[pos] == '-')) {
+        negative = input[pos] == '-';
+        pos++;
+      }
+      if (end()) {
+        return fail(ValidationError::UnexpectedEnd);
+      }
+      if (!isDigit(input[pos])) {
+        return fail(ValidationError::InvalidNumber);
+      }
+      for (; !end() && isDigit(input[pos]); pos++) {
+        // Saturates far beyond any exponent that could matter.
+        if (exponent < 1'000'000'000) {
+          exponent = exponent * 10 + (input[pos] - '0');
+        }
+      }
+      if (negative) {
+        exponent = -exponent;
+      }
+    }
+    // Json::fromString rejects numbers that overflow a double; underflow to
+    // zero or a subnormal is accepted. Only |value| in [1e308, 1e309) needs
+    // converting to tell.
+    int64_t scale = zero ? 0 : magnitude + exponent;
+    if (scale > 309) {
+      pos = start;
+      return fail(ValidationError::InvalidNumber);
+    }
+    if (scale == 309) {
+      double value;
+      auto result = std::from_chars(input.data() + start, input.data() + pos,
+                                    value);
+      if (result.ec == std::errc::result_out_of_range) {
+        pos = start;
+        return fail(ValidationError::InvalidNumber);
+      }
+    }
+    return true;
+  }
+};
+}  // namespace
+
+std::string_view validationErrorName(ValidationError error) {
+  static constexpr std::string_view kNames[] = {
+      "none",          "unexpectedEnd", "unexpectedCharacter",
+      "controlCharacter", "invalidUtf8", "invalidEscape",
+      "invalidNumber", "invalidLiteral", "tooDeep",
+      "trailingContent"};
+  static_assert(std::size(kNames) ==
+                static_cast<size_t>(ValidationError::TrailingContent) + 1);
+  return kNames[static_cast<size_t>(error)];
+}
+
+ValidationResult validate(std::string_view input) noexcept {
+  return Validator(input).run();
+}
+}  // namespace jerry
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+namespace jerry {
+enum class ValidationError {
+  None,
+  /** The input ended inside a value, or held no value at all. **/
+  UnexpectedEnd,
+  /** A byte that cannot start or continue the document at its position. **/
+  UnexpectedCharacter,
+  /** An unescaped byte below 0x20 inside a string. **/
+  ControlCharacter,
+  /** A string byte that starts no well-formed UTF-8 sequence. **/
+  InvalidUtf8,
+  /** An unknown escape, bad `\u` digits or an unpaired surrogate. **/
+  InvalidEscape,
+  /** A number that breaks the grammar or overflows a double. **/
+  InvalidNumber,
+  /** A misspelled `true`, `false` or `null`. **/
+  InvalidLiteral,
+  /** Containers nested more than kMaxValidationDepth deep. **/
+  TooDeep,
+  /** Something other than whitespace after the value. **/
+  TrailingContent
+};
+
+std::string_view validationErrorName(ValidationError error);
+
+inline constexpr size_t kMaxValidationDepth = 1024;
+
+struct ValidationResult {
+  ValidationError error;
+  /** Offset of the byte at which the input stopped being valid JSON (the
+   * first byte of an overflowing number), or the input size when valid. **/
+  size_t offset;
+
+  explicit operator bool() const noexcept {
+    return error == ValidationError::None;
+  }
+};
+
+/**
+ * @brief Checks that input is one RFC 8259 JSON document, building nothing.
+ *
+ * Accepts exactly what Json::fromString accepts: the full grammar, strings
+ * of well-formed UTF-8, escapes including surrogate pairing, whitespace of
+ * space, tab, line feed and carriage return, and numbers within the range
+ * of a double. Never allocates; nesting is tracked in a fixed bitset and
+ * strings are scanned 16 bytes at a time by findStringSpecial.
+ */
+ValidationResult validate(std::string_view input) noexcept;
+}  // namespace jerry
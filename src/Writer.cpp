@@ -0,0 +1,230 @@
+#include "Writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#include "StringDecoder.h"
+
+namespace jerry {
+Writer::Writer(std::string& out, WriteOptions options)
+    : out(&out), options(options) {}
+
+Writer::Writer(Sink sink, WriteOptions options)
+    : out(&buffer), sink(std::move(sink)), options(options) {
+  buffer.reserve(kFlushBytes + (kFlushBytes >> 2));
+}
+
+Writer::~Writer() { flush(); }
+
+void Writer::flush() {
+  if (sink && !buffer.empty()) {
+    sink(buffer);
+    buffer.clear();
+  }
+}
+
+void Writer::write(const JsonValue& value) {
+  std::visit(
+      [this](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::monostate>) {
+          onNull();
+        } else if constexpr (std::is_same_v<T, bool>) {
+          onBool(v);
+        } else if constexpr (std::is_same_v<T, int64_t> ||
+                             std::is_same_v<T, double>) {
+          onNumber(v);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+          onString(v);
+        } else if constexpr (std::is_same_v<T, std::vector<JsonValue>>) {
+          onArrayStart();
+          for (const auto& element : v) {
+            write(element);
+          }
+          onArrayEnd();
+        } else {
+          onObjectStart();
+          for (const auto& [key, member] : v) {
+            onKey(key);
+            write(member);
+          }
+          onObjectEnd();
+        }
+      },
+      value.value);
+}
+
+bool Writer::onObjectStart() {
+  open('{');
+  return true;
+}
+
+bool Writer::onObjectEnd() {
+  close('}');
+  return true;
+}
+
+bool Writer::onArrayStart() {
+  open('[');
+  return true;
+}
+
+bool Writer::onArrayEnd() {
+  close(']');
+  return true;
+}
+
+bool Writer::onKey(std::string_view key) {
+  beforeValue();
+  writeString(key);
+  out->append(options.pretty ? ": " : ":");
+  afterKey = true;
+  return true;
+}
+
+bool Writer::onString(std::string_view s) {
+  beforeValue();
+  writeString(s);
+  afterValue();
+  return true;
+}
+
+bool Writer::onNumber(int64_t n) {
+  beforeValue();
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), n);
+  out->append(digits, result.ptr);
+  afterValue();
+  return true;
+}
+
+bool Writer::onNumber(double n) {
+  if (!std::isfinite(n)) {
+    return onNull();
+  }
+  beforeValue();
+  char digits[32];
+  auto result = std::to_chars(digits, digits + sizeof(digits), n);
+  out->append(digits, result.ptr);
+  // Shortest form drops the fraction of a whole double ("150", "-0"), which
+  // would read back as int64_t and lose -0's sign.
+  if (std::find_if(digits, result.ptr, [](char c) {
+        return c == '.' || c == 'e' || c == 'E';
+      }) == result.ptr) {
+    out->append(".0");
+  }
+  afterValue();
+  return true;
+}
+
+bool Writer::onBool(bool b) {
+  beforeValue();
+  out->append(b ? "true" : "false");
+  afterValue();
+  return true;
+}
+
+bool Writer::onNull() {
+  beforeValue();
+  out->append("null");
+  afterValue();
+  return true;
+}
+
+// Writes the separator and indentation that precede a value or key.
+void Writer::beforeValue() {
+  if (afterKey) {
+    afterKey = false;
+    return;
+  }
+  if (nonEmpty.empty()) {
+    return;
+  }
+  if (nonEmpty.back()) {
+    out->push_back(',');
+  }
+  nonEmpty.back() = true;
+  newline();
+}
+
+void Writer::afterValue() {
+  if (sink && buffer.size() >= kFlushBytes) {
+    flush();
+  }
+}
+
+void Writer::open(char c) {
+  beforeValue();
+  out->push_back(c);
+  nonEmpty.push_back(false);
+}
+
+void Writer::close(char c) {
+  bool hadMembers = nonEmpty.back();
+  nonEmpty.pop_back();
+  if (hadMembers) {
+    newline();
+  }
+  out->push_back(c);
+  afterValue();
+}
+
+void Writer::newline() {
+  if (options.pretty) {
+    out->push_back('\n');
+    out->append(nonEmpty.size() * options.indent, ' ');
+  }
+}
+
+void Writer::writeString(std::string_view s) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  out->push_back('"');
+  size_t pos = 0;
+  while (pos < s.size()) {
+    size_t special = findStringSpecial(s, pos);
+    out->append(s.data() + pos, special - pos);
+    if (special >= s.size()) {
+      break;
+    }
+    char c = s[special];
+    switch (c) {
+      case '"':
+        out->append("\\\"");
+        break;
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\b':
+        out->append("\\b");
+        break;
+      case '\f':
+        out->append("\\f");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      case '\r':
+        out->append("\\r");
+        break;
+      case '\t':
+        out->append("\\t");
+        break;
+      default: {
+        char escape[] = {'\\', 'u', '0', '0', kHex[(c >> 4) & 0xF],
+                         kHex[c & 0xF]};
+        out->append(escape, sizeof(escape));
+      }
+    }
+    pos = special + 1;
+  }
+  out->push_back('"');
+}
+
+std::string toJson(const JsonValue& value, const WriteOptions& options) {
+  std::string out;
+  Writer writer(out, options);
+  writer.write(value);
+  return out;
+}
+}  // namespace jerry
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Json.h"
+
+namespace jerry {
+struct WriteOptions {
+  /** Newlines and indentation; otherwise no whitespace at all. **/
+  bool pretty = false;
+  /** Spaces per nesting level when pretty. **/
+  size_t indent = 2;
+};
+
+/**
+ * @brief Serializes JSON into a growable buffer or a caller-supplied sink.
+ *
+ * Output is appended to one std::string, so writing a document costs no
+ * allocation per node. With a sink, the buffer is handed over whenever it
+ * passes kFlushBytes and reused, bounding memory for any document size.
+ *
+ * Numbers use the shortest representation that reads back to the same
+ * value (std::to_chars); a whole double gets a ".0" so that it reads back as
+ * a double rather than an int64_t. NaN and infinities, which JSON cannot
+ * express, are written as null. Strings are copied in bulk between characters that need
+ * escaping, found 16 bytes at a time.
+ *
+ * The Writer is also a SaxHandler, so events from parseSax or a
+ * StreamParser can be re-emitted without building a JsonValue.
+ */
+class Writer {
+public:
+  using Sink = std::function<void(std::string_view)>;
+
+  static constexpr size_t kFlushBytes = 64 << 10;
+
+  /** Appends to out. **/
+  explicit Writer(std::string& out, WriteOptions options = {});
+  /** Hands output to sink in chunks. Remaining output is flushed on
+   * destruction. **/
+  explicit Writer(Sink sink, WriteOptions options = {});
+  ~Writer();
+
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  void write(const JsonValue& value);
+  /** Passes buffered output to the sink. No-op when writing to a string. **/
+  void flush();
+
+  bool onObjectStart();
+  bool onObjectEnd();
+  bool onArrayStart();
+  bool onArrayEnd();
+  bool onKey(std::string_view key);
+  bool onString(std::string_view s);
+  bool onNumber(int64_t n);
+  bool onNumber(double n);
+  bool onBool(bool b);
+  bool onNull();
+
+private:
+  std::string buffer;
+  std::string* out;
+  Sink sink;
+  WriteOptions options;
+  // Whether each open container already has a member.
+  std::vector<bool> nonEmpty;
+  bool afterKey = false;
+
+  void beforeValue();
+  void afterValue();
+  void open(char c);
+  void close(char c);
+  void newline();
+  void writeString(std::string_view s);
+};
+
+/** Serializes value into a new string. **/
+std::string toJson(const JsonValue& value, const WriteOptions& options = {});
+}  // namespace jerry
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "Document.h"
+#include "ParseCorpus.h"
+
+using namespace jerry;
+
+class DocumentParseTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(DocumentParseTest, MatchesJsonTest) {
+  const auto& input = GetParam();
+  auto doc = Document::fromString(input);
+  auto json = Json::fromString(input);
+  ASSERT_TRUE(doc);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(doc->root().toJsonValue(), json->getValue());
+}
+
+INSTANTIATE_TEST_SUITE_P(DocumentParseTests, DocumentParseTest,
+                         ::testing::ValuesIn(test::parseCorpus()));
+
+TEST(DocumentTest, AccessorTest) {
+  auto doc = Document::fromString(
+      "{\"id\": 42, \"name\": \"jerry\", \"tags\": [\"a\", \"b\"], "
+      "\"ratio\": 0.5, \"ok\": true, \"none\": null}");
+  ASSERT_TRUE(doc);
+  auto root = doc->root();
+  ASSERT_TRUE(root.isObject());
+  EXPECT_EQ(root.size(), 6u);
+  EXPECT_EQ(root["id"].getInt64(), 42);
+  EXPECT_EQ(root["id"].getDouble(), 42.0);
+  EXPECT_EQ(root["name"].getString(), "jerry");
+  EXPECT_EQ(root["tags"].size(), 2u);
+  EXPECT_EQ(root["tags"][1].getString(), "b");
+  EXPECT_EQ(root["ratio"].getDouble(), 0.5);
+  EXPECT_FALSE(root["ratio"].getInt64());
+  EXPECT_EQ(root["ok"].getBool(), true);
+  EXPECT_TRUE(root["none"].isNull());
+
+  // Members keep document order.
+  EXPECT_EQ(root.keyAt(0), "id");
+  EXPECT_EQ(root.keyAt(5), "none");
+
+  // Failed lookups produce invalid handles instead of throwing.
+  EXPECT_FALSE(root["missing"]);
+  EXPECT_FALSE(root["tags"][2]);
+  EXPECT_FALSE(root["name"]["x"]);
+  EXPECT_FALSE(root["missing"].getString());
+  EXPECT_EQ(root["missing"].type(), NodeType::Invalid);
+  EXPECT_EQ(root["missing"].toJsonValue(), JsonValue());
+  EXPECT_EQ(root["tags"].type(), NodeType::Array);
+}
+
+TEST(DocumentTest, RejectTest) {
+  EXPECT_FALSE(Document::fromString("[1 2]"));
+  EXPECT_FALSE(Document::fromString("{\"a\":}"));
+  EXPECT_FALSE(Document::fromString("true false"));
+  EXPECT_FALSE(Document::fromString("{\"caf\xC3\": 1}"));
+  EXPECT_FALSE(Document::fromString("[\"\\u00e9 \xED\xA0\x80\"]"));
+  EXPECT_FALSE(Document::fromString(std::string(2000, '[')));
+}
+
+TEST(DocumentTest, ArenaTest) {
+  std::string input = "[";
+  for (int i = 0; i < 1000; i++) {
+    input += (i ? "," : "") + std::string("{\"k\":") + std::to_string(i) + "}";
+  }
+  input += "]";
+  auto doc = Document::fromString(input);
+  ASSERT_TRUE(doc);
+  EXPECT_EQ(doc->root().size(), 1000u);
+  EXPECT_EQ(doc->root()[999]["k"].getInt64(), 999);
+  // 1 root + 1000 objects + 2000 key/value nodes; the repeated key is
+  // stored once, in the key pool.
+  EXPECT_EQ(doc->getArena().bytesUsed(), 3001 * sizeof(Node));
+  KeyPoolStats stats = doc->getKeyPool().stats();
+  EXPECT_EQ(stats.unique, 1u);
+  EXPECT_EQ(stats.bytesStored, 1u);
+  EXPECT_EQ(stats.bytesRequested, 1000u);
+}
+
+TEST(DocumentTest, InternedKeyTest) {
+  auto doc = Document::fromString(R"([{"id":1,"n":"a"},{"n":"b","id":2}])");
+  ASSERT_TRUE(doc);
+  auto id = doc->getKeyPool().find("id");
+  ASSERT_TRUE(id);
+  EXPECT_EQ(doc->root()[0].keyAt(0).data(), id->data());
+  EXPECT_EQ(doc->root()[1].keyAt(1).data(), id->data());
+  EXPECT_EQ(doc->root()[1][*id].getInt64(), 2);
+  EXPECT_FALSE(doc->getKeyPool().find("missing"));
+
+  auto withEmpty = Document::fromString(R"({"a":1,"":2,"b":3})");
+  ASSERT_TRUE(withEmpty);
+  const KeyPool& pool = withEmpty->getKeyPool();
+  auto a = pool.find("a");
+  auto empty = pool.find("");
+  auto b = pool.find("b");
+  ASSERT_TRUE(a && empty && b);
+  EXPECT_NE(*empty, *b);
+  EXPECT_EQ(withEmpty->root()[*a].getInt64(), 1);
+  EXPECT_EQ(withEmpty->root()[*empty].getInt64(), 2);
+  EXPECT_EQ(withEmpty->root()[*b].getInt64(), 3);
+}
+
+TEST(DocumentTest, SharedKeyPoolTest) {
+  KeyPool pool;
+  auto first = Document::fromString(R"({"name":"x","size":1})", pool);
+  auto second = Document::fromString(R"({"size":2,"name":"y"})", pool);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_EQ(&first->getKeyPool(), &pool);
+  EXPECT_EQ(first->root().keyAt(0).data(), second->root().keyAt(1).data());
+  InternedKey size = pool.intern("size");
+  EXPECT_EQ(first->root()[size].getInt64(), 1);
+  EXPECT_EQ(second->root()[size].getInt64(), 2);
+  EXPECT_EQ(pool.stats().unique, 2u);
+}
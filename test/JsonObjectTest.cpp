@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "Json.h"
+#include "Writer.h"
+
+using namespace jerry;
+
+// Object sizes either side of the point where the hash index takes over.
+class JsonObjectTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(JsonObjectTest, LookupTest) {
+  JsonObject object;
+  for (size_t i = 0; i < GetParam(); i++) {
+    std::string key = "key" + std::to_string(i);
+    auto [it, added] =
+        object.insert_or_assign(key, JsonValue(static_cast<int64_t>(i)));
+    EXPECT_TRUE(added);
+    EXPECT_EQ(it->first, key);
+  }
+  ASSERT_EQ(object.size(), GetParam());
+  for (size_t i = 0; i < GetParam(); i++) {
+    std::string key = "key" + std::to_string(i);
+    auto it = object.find(key);
+    ASSERT_NE(it, object.end());
+    EXPECT_EQ(it->second, JsonValue(static_cast<int64_t>(i)));
+    // Members stay in insertion order.
+    EXPECT_EQ((object.begin() + static_cast<std::ptrdiff_t>(i))->first, key);
+  }
+  EXPECT_FALSE(object.contains("key"));
+  EXPECT_FALSE(object.contains("key" + std::to_string(GetParam())));
+  EXPECT_THROW(object.at("missing"), std::out_of_range);
+}
+
+TEST_P(JsonObjectTest, DuplicateKeyTest) {
+  JsonObject object;
+  for (size_t i = 0; i < GetParam(); i++) {
+    object["key" + std::to_string(i)] = JsonValue(1);
+  }
+  // Replacing a value keeps its position.
+  auto [it, added] = object.insert_or_assign("key0", JsonValue(2));
+  if (GetParam() == 0) {
+    EXPECT_TRUE(added);
+  } else {
+    EXPECT_FALSE(added);
+    EXPECT_EQ(it, object.begin());
+  }
+  EXPECT_EQ(object.at("key0"), JsonValue(2));
+  EXPECT_EQ(object.size(), std::max<size_t>(GetParam(), 1));
+}
+
+TEST_P(JsonObjectTest, EraseTest) {
+  JsonObject object;
+  for (size_t i = 0; i < GetParam(); i++) {
+    object["key" + std::to_string(i)] = JsonValue(static_cast<int64_t>(i));
+  }
+  for (size_t i = 0; i < GetParam(); i += 2) {
+    EXPECT_EQ(object.erase("key" + std::to_string(i)), 1u);
+  }
+  EXPECT_EQ(object.erase("missing"), 0u);
+  EXPECT_EQ(object.size(), GetParam() / 2);
+  for (size_t i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(object.contains("key" + std::to_string(i)), i % 2 == 1);
+  }
+}
+
+TEST_P(JsonObjectTest, EqualityIgnoresOrderTest) {
+  JsonObject forward;
+  JsonObject backward;
+  for (size_t i = 0; i < GetParam(); i++) {
+    forward["key" + std::to_string(i)] = JsonValue(static_cast<int64_t>(i));
+    size_t j = GetParam() - 1 - i;
+    backward["key" + std::to_string(j)] = JsonValue(static_cast<int64_t>(j));
+  }
+  EXPECT_EQ(forward, backward);
+  if (GetParam() > 0) {
+    backward["key0"] = JsonValue("changed");
+    EXPECT_FALSE(forward == backward);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    JsonObjectTests, JsonObjectTest,
+    ::testing::Values(0, 1, 3, JsonObject::kIndexThreshold,
+                      JsonObject::kIndexThreshold + 1, 100, 1000));
+
+TEST(JsonObjectTest, DocumentOrderTest) {
+  std::string input = R"({"z":1,"a":2,"m":{"y":true,"b":null}})";
+  auto json = Json::fromString(input);
+  ASSERT_TRUE(json);
+  // Keys come back out in the order they were read.
+  EXPECT_EQ(json->getValue().toString(), input);
+}
+
+TEST(JsonObjectTest, KeyStorageTest) {
+  JsonKey inlineKey(std::string(JsonKey::kInlineSize, 'k'));
+  JsonKey sharedKey(std::string(JsonKey::kInlineSize + 1, 'k'));
+  EXPECT_FALSE(inlineKey.shared());
+  EXPECT_TRUE(sharedKey.shared());
+  EXPECT_EQ(sizeof(JsonKey), 24u);
+
+  // Copies of a long key share its buffer; moves leave an empty key behind.
+  JsonKey copy = sharedKey;
+  EXPECT_EQ(copy.data(), sharedKey.data());
+  JsonKey moved = std::move(copy);
+  EXPECT_EQ(moved.data(), sharedKey.data());
+  EXPECT_TRUE(copy.empty());
+  copy = inlineKey;
+  EXPECT_EQ(copy, inlineKey);
+  EXPECT_NE(copy, sharedKey);
+  EXPECT_EQ(copy.c_str()[copy.size()], '\0');
+  EXPECT_EQ(sharedKey.c_str()[sharedKey.size()], '\0');
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <array>
+#include <memory_resource>
+
 #include "Json.h"
+#include "KeyPool.h"
+#include "ThreadPool.h"
 
 using namespace jerry;
 
@@ -14,17 +19,61 @@ TEST_P(JsonParseTest, jsonObjectParseTest) {
   EXPECT_EQ(json, expected);
 }
 
+TEST_P(JsonParseTest, jsonParallelParseTest) {
+  const auto& [input, expected] = GetParam();
+  ThreadPool pool(3);
+  // A one-byte minimum forces even tiny arrays to be split.
+  auto json = Json::fromStringParallel(input, pool, 1);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json, expected);
+}
+
+TEST_P(JsonParseTest, jsonFromStateTest) {
+  const auto& [input, expected] = GetParam();
+  TokenizerState state(input, 0);
+  auto json = Json::fromState(state);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->first, expected);
+  EXPECT_EQ(json->second.getPosition(), state.getPosition());
+  // Only trailing whitespace may follow the value.
+  EXPECT_EQ(input.find_first_not_of(" \t\n\r", state.getPosition()),
+            std::string::npos);
+}
+
+TEST_P(JsonParseTest, jsonInternedParseTest) {
+  const auto& [input, expected] = GetParam();
+  KeyPool keys;
+  auto json = Json::fromString(input, keys);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json, expected);
+  TokenizerState state(input, 0);
+  auto fromState = Json::fromState(state, keys);
+  ASSERT_TRUE(fromState);
+  EXPECT_EQ(fromState->first, expected);
+}
+
+TEST_P(JsonParseTest, jsonPmrParseTest) {
+  const auto& [input, expected] = GetParam();
+  std::array<std::byte, 4096> buffer;
+  // Running out of the buffer would throw rather than fall back to the heap.
+  std::pmr::monotonic_buffer_resource resource(
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  auto json = Json::fromString(input, &resource);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->toJsonValue(), expected.getValue());
+}
+
 INSTANTIATE_TEST_SUITE_P(
   JsonParseTests, JsonParseTest,
   ::testing::Values(
     std::make_pair("[\"hello\", \"beautiful\", \"world\"]", Json(std::vector<JsonValue>({"hello", "beautiful", "world"}))),
-    std::make_pair("{\"hey\" : \"dude\"}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{{"hey", JsonValue("dude")}}))),
+    std::make_pair("{\"hey\" : \"dude\"}", Json(JsonValue(JsonObject{{"hey", JsonValue("dude")}}))),
     std::make_pair("true", Json(JsonValue(true))),
-    std::make_pair("{\"enable gamer mode?\" : true}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{{"enable gamer mode?", JsonValue(true)}}))),
+    std::make_pair("{\"enable gamer mode?\" : true}", Json(JsonValue(JsonObject{{"enable gamer mode?", JsonValue(true)}}))),
     std::make_pair("{\"NESTED json objects\" : {\"cowabunga\" : [\"surfs\",\"up\"]}}",
-      Json(JsonValue(std::unordered_map<std::string, JsonValue>{
+      Json(JsonValue(JsonObject{
       {"NESTED json objects",
-       JsonValue(std::unordered_map<std::string, JsonValue>{
+       JsonValue(JsonObject{
          {"cowabunga", JsonValue(std::vector<JsonValue>({"surfs", "up"}))}
        })
       }
@@ -32,25 +81,217 @@ INSTANTIATE_TEST_SUITE_P(
     ),
     std::make_pair("123", Json(JsonValue(123))),
     std::make_pair("-45", Json(JsonValue(-45))),
-    // TODO parsing doubles is broken (rounding errors)
     std::make_pair("-45.67", Json(JsonValue(-45.67))),
     std::make_pair("null", Json(JsonValue())),
+    std::make_pair("[9007199254740993, 1.5e2, -0]", Json(std::vector<JsonValue>({
+      JsonValue(int64_t{9007199254740993}), 150, JsonValue(-0.0)}))),
     std::make_pair("false", Json(JsonValue(false))),
     std::make_pair("[1, 2, 3, 4]", Json(std::vector<JsonValue>({1, 2, 3, 4}))),
-    std::make_pair("{\"a\":1,\"b\":2}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{{"a", 1}, {"b", 2}}))),
-    std::make_pair("{\"emptyArray\":[]}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{{"emptyArray", JsonValue(std::vector<JsonValue>{})}}))),
-    std::make_pair("{\"emptyObject\":{}}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{{"emptyObject", JsonValue(std::unordered_map<std::string, JsonValue>{})}}))),
+    std::make_pair("{\"a\":1,\"b\":2}", Json(JsonValue(JsonObject{{"a", 1}, {"b", 2}}))),
+    std::make_pair("{\"emptyArray\":[]}", Json(JsonValue(JsonObject{{"emptyArray", JsonValue(std::vector<JsonValue>{})}}))),
+    std::make_pair("{\"emptyObject\":{}}", Json(JsonValue(JsonObject{{"emptyObject", JsonValue(JsonObject{})}}))),
     std::make_pair("[{\"x\":1}, {\"y\":2}]", Json(std::vector<JsonValue>{
-      JsonValue(std::unordered_map<std::string, JsonValue>{{"x", 1}}),
-      JsonValue(std::unordered_map<std::string, JsonValue>{{"y", 2}})
+      JsonValue(JsonObject{{"x", 1}}),
+      JsonValue(JsonObject{{"y", 2}})
     })),
-    std::make_pair("{\"nested\":[{\"a\":true}, {\"b\":false}]}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{
+    std::make_pair("{\"nested\":[{\"a\":true}, {\"b\":false}]}", Json(JsonValue(JsonObject{
       {"nested", JsonValue(std::vector<JsonValue>{
-        JsonValue(std::unordered_map<std::string, JsonValue>{{"a", true}}),
-        JsonValue(std::unordered_map<std::string, JsonValue>{{"b", false}})
+        JsonValue(JsonObject{{"a", true}}),
+        JsonValue(JsonObject{{"b", false}})
       })}
     }))),
     std::make_pair("\"string with \\\"escaped quotes\\\"\"", Json(JsonValue("string with \"escaped quotes\""))),
-    std::make_pair("{\"unicode\":\"\\u263A\"}", Json(JsonValue(std::unordered_map<std::string, JsonValue>{{"unicode", JsonValue("\u263A")}})))
+    std::make_pair("{\"unicode\":\"\\u263A\"}", Json(JsonValue(JsonObject{{"unicode", JsonValue("\u263A")}}))),
+    std::make_pair("\t{\n\t\"a\" :\r\n [1,\t2]\n}\r\n", Json(JsonValue(JsonObject{{"a", JsonValue(std::vector<JsonValue>{1, 2})}})))
+  )
+);
+
+class JsonRejectTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(JsonRejectTest, jsonRejectTest) {
+  EXPECT_FALSE(Json::fromString(GetParam()));
+  ThreadPool pool(3);
+  EXPECT_FALSE(Json::fromStringParallel(GetParam(), pool, 1));
+  EXPECT_FALSE(Json::fromString(GetParam(), std::pmr::new_delete_resource()));
+  KeyPool keys;
+  EXPECT_FALSE(Json::fromString(GetParam(), keys));
+  // fromState parses a prefix, so trailing input is the caller's to reject.
+  TokenizerState state(GetParam(), 0);
+  auto json = Json::fromState(state);
+  EXPECT_TRUE(!json || state.getPosition() < GetParam().size());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  JsonRejectTests, JsonRejectTest,
+  ::testing::Values(
+    "",
+    "[1 2]",
+    "[1,]",
+    "{\"a\" 1}",
+    "{\"a\":1,}",
+    "{1:2}",
+    "\"unterminated",
+    "true false",
+    "[\"a\"x]",
+    "]",
+    "[1, 2, 3,]",
+    "[, 1, 2, 3]",
+    "[1, 2, 3] 4",
+    "[1, [2, 3], {\"a\": 4}",
+    "\"\xC3\"",
+    "{\"caf\xC3\": 1}",
+    "[\"\xED\xA0\x80\"]",
+    "\"\xE2\x98\\n\"",
+    "[\"a string longer than one 64-byte block, then \xF4\x90\x80\x80\"]"
   )
-);
\ No newline at end of file
+);
+
+TEST(JsonKeyPoolTest, RecordArrayTest) {
+  std::string input = "[";
+  for (int i = 0; i < 100; i++) {
+    input += (i ? "," : "") + std::string("{\"id\":") + std::to_string(i) +
+             ",\"a rather long field name\":\"x\",\"k\\u00e9y\":null}";
+  }
+  input += "]";
+
+  std::optional<Json> json;
+  KeyPoolStats stats;
+  {
+    KeyPool keys;
+    json = Json::fromString(input, keys);
+    stats = keys.stats();
+  }
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json, Json::fromString(input));
+  EXPECT_EQ(stats.lookups, 300u);
+  EXPECT_EQ(stats.unique, 3u);
+  EXPECT_EQ(stats.bytesStored, 2 + 24 + 4u);
+  EXPECT_EQ(stats.bytesRequested, 100 * stats.bytesStored);
+
+  // Every record holds the same three buffers, which outlive the pool.
+  JsonValue root = std::move(*json).getValue();
+  const auto& records = std::get<std::vector<JsonValue>>(root.value);
+  const auto& first = std::get<JsonObject>(records.front().value);
+  for (const auto& record : records) {
+    const auto& members = std::get<JsonObject>(record.value);
+    ASSERT_EQ(members.size(), 3u);
+    for (auto a = members.begin(), b = first.begin(); a != members.end();
+         ++a, ++b) {
+      EXPECT_TRUE(a->first.shared());
+      EXPECT_EQ(a->first.data(), b->first.data());
+    }
+  }
+  EXPECT_EQ(first.begin()[2].first, "k\u00e9y");
+  EXPECT_TRUE(first.contains("a rather long field name"));
+}
+
+TEST(JsonUtf8Test, ReplaceTest) {
+  std::string input = "{\"caf\xC3\": [\"\xE2\x98\", \"ok \xE2\x98\xBA\"]}";
+  EXPECT_FALSE(Json::fromString(input, utf8::Policy::Reject));
+  auto json = Json::fromString(input, utf8::Policy::Replace);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->getValue(),
+            JsonValue(JsonObject{
+                {"caf\xEF\xBF\xBD",
+                 JsonValue(std::vector<JsonValue>{"\xEF\xBF\xBD",
+                                                  "ok \xE2\x98\xBA"})}}));
+}
+
+TEST(JsonParallelTest, LargeArrayTest) {
+  std::string input = "[";
+  std::vector<JsonValue> expected;
+  for (int i = 0; i < 10000; i++) {
+    input += (i ? ", " : "") + std::string("{\"id\": ") + std::to_string(i) +
+             ", \"tags\": [\"a,b\", \"]\"]}";
+    expected.push_back(JsonValue(JsonObject{
+        {"id", i}, {"tags", JsonValue(std::vector<JsonValue>{"a,b", "]"})}}));
+  }
+  input += "]";
+  ThreadPool pool(4);
+  auto json = Json::fromStringParallel(input, pool, 1024);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->getValue(), JsonValue(std::move(expected)));
+}
+
+TEST(JsonParallelTest, NestedInPoolTest) {
+  std::string input = "[";
+  for (int i = 0; i < 1000; i++) {
+    input += (i ? ", " : "") + std::to_string(i);
+  }
+  input += "]";
+  auto expected = Json::fromString(input);
+  ASSERT_TRUE(expected);
+  // Called from the pool's only worker, the parse must run its own slices.
+  ThreadPool pool(1);
+  BoundedQueue<std::optional<Json>> result(1);
+  pool.submit([&] { result.push(Json::fromStringParallel(input, pool, 64)); });
+  auto json = result.pop();
+  ASSERT_TRUE(json && *json);
+  EXPECT_EQ(**json, *expected);
+}
+
+// Counts what reaches it, so a test can see the parse never got there.
+class CountingResource : public std::pmr::memory_resource {
+public:
+  size_t allocations = 0;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(JsonPmrTest, EverythingInResourceTest) {
+  CountingResource fallback;
+  std::pmr::memory_resource* previous =
+      std::pmr::set_default_resource(&fallback);
+  std::array<std::byte, 8192> buffer;
+  std::pmr::monotonic_buffer_resource resource(
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  auto json = Json::fromString(
+      R"({"a key longer than the small-string buffer": [)"
+      R"("an escaped\tvalue that is also long", 1, 2.5, null],)"
+      R"("nested": {"k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5,)"
+      R"("k6": 6, "k7": 7, "k8": 8, "k9": 9}})",
+      &resource);
+  std::pmr::set_default_resource(previous);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(fallback.allocations, 0u);
+
+  auto& root = std::get<pmr::JsonObject>(json->value);
+  EXPECT_EQ(root.get_allocator().resource(), &resource);
+  auto& list = std::get<pmr::JsonArray>(
+      root.at("a key longer than the small-string buffer").value);
+  EXPECT_EQ(list.get_allocator().resource(), &resource);
+  auto& text = std::get<std::pmr::string>(list[0].value);
+  EXPECT_EQ(text, "an escaped\tvalue that is also long");
+  EXPECT_EQ(text.get_allocator().resource(), &resource);
+  auto& nested = std::get<pmr::JsonObject>(root.at("nested").value);
+  EXPECT_EQ(nested.at("k9"), pmr::JsonValue(9));
+  EXPECT_EQ(nested.begin()->first.get_allocator().resource(), &resource);
+}
+
+TEST(JsonPmrTest, CopyIntoResourceTest) {
+  std::pmr::monotonic_buffer_resource first;
+  std::pmr::monotonic_buffer_resource second;
+  auto json = Json::fromString(
+      R"({"strings": ["long enough to leave the small-string buffer"]})",
+      &first);
+  ASSERT_TRUE(json);
+  pmr::JsonValue copy(*json, &second);
+  EXPECT_EQ(copy, *json);
+  auto& list = std::get<pmr::JsonArray>(
+      std::get<pmr::JsonObject>(copy.value).at("strings").value);
+  EXPECT_EQ(list.get_allocator().resource(), &second);
+  EXPECT_EQ(std::get<std::pmr::string>(list[0].value)
+                .get_allocator()
+                .resource(),
+            &second);
+}
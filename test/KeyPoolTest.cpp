@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "JsonKey.h"
+#include "KeyPool.h"
+
+using namespace jerry;
+
+class KeyPoolTest : public ::testing::TestWithParam<std::vector<std::string>> {
+};
+
+TEST_P(KeyPoolTest, InternTest) {
+  KeyPool pool;
+  std::unordered_set<std::string> distinct;
+  size_t requested = 0;
+  for (const std::string& key : GetParam()) {
+    InternedKey interned = pool.intern(key);
+    EXPECT_EQ(interned.view(), key);
+    // Interning a copy yields the same canonical bytes.
+    EXPECT_EQ(pool.intern(std::string(key)), interned);
+    EXPECT_EQ(pool.find(key), interned);
+    distinct.insert(key);
+    requested += 2 * key.size();
+  }
+  KeyPoolStats stats = pool.stats();
+  EXPECT_EQ(stats.lookups, 2 * GetParam().size());
+  EXPECT_EQ(stats.unique, distinct.size());
+  EXPECT_EQ(stats.bytesRequested, requested);
+  size_t stored = 0;
+  for (const std::string& key : distinct) {
+    stored += key.size();
+  }
+  EXPECT_EQ(stats.bytesStored, stored);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    KeyPoolTests, KeyPoolTest,
+    ::testing::Values(std::vector<std::string>{},
+                      std::vector<std::string>{"id"},
+                      std::vector<std::string>{"id", "name", "id", "id"},
+                      std::vector<std::string>{"", "a", "", "ab", "a"},
+                      std::vector<std::string>{"a", "", "b"},
+                      std::vector<std::string>{"caf\xc3\xa9", "cafe"}));
+
+TEST(KeyPoolTest, FindDoesNotAddTest) {
+  KeyPool pool;
+  EXPECT_FALSE(pool.find("key"));
+  EXPECT_EQ(pool.stats().unique, 0u);
+  InternedKey a = pool.intern("key");
+  InternedKey b = pool.intern("other");
+  EXPECT_NE(a, b);
+  EXPECT_NE(std::hash<InternedKey>()(a), std::hash<InternedKey>()(b));
+
+  // The empty key gets storage of its own, distinct from the next key.
+  InternedKey empty = pool.intern("");
+  InternedKey next = pool.intern("next");
+  EXPECT_NE(empty, next);
+  EXPECT_NE(empty.data(), next.data());
+  EXPECT_EQ(pool.find(""), empty);
+}
+
+TEST(KeyPoolTest, ConcurrentInternTest) {
+  KeyPool pool(true);
+  std::vector<std::vector<const char*>> seen(4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < seen.size(); t++) {
+    threads.emplace_back([&pool, &seen, t] {
+      for (int i = 0; i < 500; i++) {
+        seen[t].push_back(pool.intern("key" + std::to_string(i % 50)).data());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // Every thread resolved each key to the same canonical copy.
+  for (size_t t = 1; t < seen.size(); t++) {
+    EXPECT_EQ(seen[t], seen[0]);
+  }
+  EXPECT_EQ(pool.stats().unique, 50u);
+  EXPECT_EQ(pool.stats().lookups, 2000u);
+}
+
+TEST(KeyPoolTest, InternJsonKeyTest) {
+  JsonKey id;
+  JsonKey name;
+  {
+    KeyPool pool;
+    id = pool.internJsonKey("id");
+    name = pool.internJsonKey("a name longer than inline");
+    // Even a short key is shared once interned.
+    EXPECT_TRUE(id.shared());
+    EXPECT_EQ(pool.internJsonKey("id").data(), id.data());
+    EXPECT_EQ(pool.internJsonKey(std::string("a name longer than inline")).data(),
+              name.data());
+    EXPECT_NE(pool.internJsonKey("").data(), id.data());
+    // InternedKeys and JsonKeys are counted together.
+    pool.intern("id");
+    KeyPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.lookups, 6u);
+    EXPECT_EQ(stats.unique, 4u);
+    EXPECT_EQ(stats.bytesStored, 2 + 25 + 2u);
+    EXPECT_EQ(stats.bytesRequested, 2 + 25 + 2 + 25 + 2u);
+  }
+  // The keys own their buffers once the pool is gone.
+  EXPECT_EQ(id, "id");
+  EXPECT_EQ(name, "a name longer than inline");
+  EXPECT_EQ(id, JsonKey("id"));
+  EXPECT_EQ(id.hash(), JsonKey("id").hash());
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "Lines.h"
+#include "ThreadPool.h"
+
+using namespace jerry;
+
+namespace {
+std::string makeLines(size_t count) {
+  std::string out;
+  for (size_t i = 0; i < count; i++) {
+    out += "{\"id\":" + std::to_string(i) + ",\"tags\":[\"a\",\"b\"]}\n";
+  }
+  return out;
+}
+
+std::vector<int64_t> ids(const std::vector<LineRecord>& records) {
+  std::vector<int64_t> out;
+  for (const auto& record : records) {
+    auto& object =
+        std::get<JsonObject>(record.value->value);
+    out.push_back(std::get<int64_t>(object.at("id").value));
+  }
+  return out;
+}
+}  // namespace
+
+class ParseLinesTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(ParseLinesTest, DeliversEveryRecordTest) {
+  std::string input = makeLines(1000);
+  ThreadPool pool(4);
+  ParseLinesOptions options;
+  options.pool = &pool;
+  options.chunkBytes = 100;
+  options.ordered = GetParam();
+  std::vector<LineRecord> records;
+  auto result = parseLines(
+      input,
+      [&records](LineRecord& record) {
+        records.push_back(std::move(record));
+        return true;
+      },
+      options);
+  EXPECT_EQ(result.records, 1000u);
+  EXPECT_EQ(result.errors, 0u);
+  EXPECT_FALSE(result.stopped);
+
+  std::vector<int64_t> got = ids(records);
+  std::vector<int64_t> expected(1000);
+  for (size_t i = 0; i < expected.size(); i++) {
+    expected[i] = static_cast<int64_t>(i);
+  }
+  if (!options.ordered) {
+    std::sort(got.begin(), got.end());
+  }
+  EXPECT_EQ(got, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(ParseLinesTests, ParseLinesTest,
+                         ::testing::Values(true, false));
+
+TEST(LinesTest, BlankAndMalformedLinesTest) {
+  std::string input = "[1]\r\n\n  \n{\"a\":\n\"last\"";
+  std::vector<LineRecord> records;
+  auto result = parseLines(input, [&records](LineRecord& record) {
+    records.push_back(std::move(record));
+    return true;
+  });
+  ASSERT_EQ(result.records, 3u);
+  EXPECT_EQ(result.errors, 1u);
+  EXPECT_EQ(records[0].text, "[1]");
+  EXPECT_EQ(records[0].value, JsonValue(std::vector<JsonValue>{1}));
+  EXPECT_EQ(records[1].offset, 9u);
+  EXPECT_FALSE(records[1].value);
+  EXPECT_EQ(records[2].value, JsonValue("last"));
+}
+
+TEST(LinesTest, StopEarlyTest) {
+  std::string input = makeLines(1000);
+  ParseLinesOptions options;
+  options.threads = 2;
+  options.chunkBytes = 64;
+  size_t seen = 0;
+  auto result = parseLines(
+      input, [&seen](LineRecord&) { return ++seen < 10; }, options);
+  EXPECT_TRUE(result.stopped);
+  EXPECT_EQ(result.records, 10u);
+  EXPECT_EQ(seen, 10u);
+}
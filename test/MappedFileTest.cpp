@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "Json.h"
+#include "MappedFile.h"
+#include "OnDemand.h"
+#include "Tape.h"
+
+using namespace jerry;
+
+namespace {
+// Writes contents to a file in the temp directory, removed on destruction.
+class TempFile {
+public:
+  explicit TempFile(const std::string& contents)
+      : path(testing::TempDir() + "jerry_" +
+             testing::UnitTest::GetInstance()->current_test_info()->name() +
+             ".json") {
+    std::ofstream(path, std::ios::binary) << contents;
+  }
+  ~TempFile() { std::remove(path.c_str()); }
+
+  const std::string path;
+};
+}  // namespace
+
+TEST(MappedFileTest, ViewTest) {
+  TempFile file("{\"a\": [1, 2]}");
+  auto mapped = MappedFile::open(file.path);
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(mapped->view(), "{\"a\": [1, 2]}");
+
+  MappedFile moved = std::move(*mapped);
+  EXPECT_EQ(moved.view(), "{\"a\": [1, 2]}");
+  EXPECT_EQ(mapped->size(), 0u);
+}
+
+TEST(MappedFileTest, EmptyAndMissingTest) {
+  TempFile empty("");
+  auto mapped = MappedFile::open(empty.path);
+  ASSERT_TRUE(mapped);
+  EXPECT_TRUE(mapped->view().empty());
+  EXPECT_FALSE(Json::fromFile(empty.path));
+
+  EXPECT_FALSE(MappedFile::open(empty.path + ".missing"));
+  EXPECT_FALSE(Json::fromFile(empty.path + ".missing"));
+  EXPECT_FALSE(Tape::fromFile(empty.path + ".missing"));
+}
+
+TEST(MappedFileTest, JsonFromFileTest) {
+  TempFile file("{\"name\": \"jerry\", \"ids\": [1, 2]}");
+  auto json = Json::fromFile(file.path);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(json->getValue(),
+            JsonValue(JsonObject{
+                {"name", "jerry"},
+                {"ids", JsonValue(std::vector<JsonValue>{1, 2})}}));
+}
+
+TEST(MappedFileTest, TapeFromFileTest) {
+  std::optional<Tape> tape;
+  std::string_view raw;
+  {
+    TempFile file("[\"plain\", \"esc\\naped\"]");
+    tape = Tape::fromFile(file.path);
+    ASSERT_TRUE(tape);
+    raw = *tape->root()[0].getRawString();
+  }
+  // The file is gone but the tape still holds the mapping.
+  EXPECT_EQ(raw, "plain");
+  EXPECT_EQ(tape->root()[1].getString(), "esc\naped");
+  Tape copy = *tape;
+  tape.reset();
+  EXPECT_EQ(copy.root()[0].getRawString(), "plain");
+}
+
+TEST(MappedFileTest, OnDemandFromFileTest) {
+  TempFile file("{\"user\": {\"id\": 42}}");
+  auto doc = ondemand::Document::fromFile(file.path);
+  ASSERT_TRUE(doc);
+  EXPECT_EQ((*doc)["user"]["id"].getInt64(), 42);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "OnDemand.h"
+#include "ParseCorpus.h"
+
+using namespace jerry;
+
+class OnDemandParseTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(OnDemandParseTest, MatchesJsonTest) {
+  const auto& input = GetParam();
+  auto doc = ondemand::Document::fromString(input);
+  auto json = Json::fromString(input);
+  ASSERT_TRUE(doc);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(doc->root().toJsonValue(), json->getValue());
+}
+
+INSTANTIATE_TEST_SUITE_P(OnDemandParseTests, OnDemandParseTest,
+                         ::testing::ValuesIn(test::parseCorpus()));
+
+TEST(OnDemandTest, NestedLookupTest) {
+  std::string input =
+      "{\"skipped\": {\"a\": [1, \"]}\", {\"b\": \"{\"}]}, "
+      "\"user\": {\"name\": \"jerry\", \"id\": 42, \"score\": 2.5, "
+      "\"admin\": false}, \"tags\": [\"x\", \"y\\n\"], \"none\": null}";
+  auto doc = ondemand::Document::fromString(input);
+  ASSERT_TRUE(doc);
+  EXPECT_EQ((*doc)["user"]["id"].getInt64(), 42);
+  EXPECT_EQ((*doc)["user"]["score"].getDouble(), 2.5);
+  EXPECT_EQ((*doc)["user"]["admin"].getBool(), false);
+  EXPECT_EQ((*doc)["tags"][1].getString(), "y\n");
+  EXPECT_EQ((*doc)["tags"][1].getRawString(), "y\\n");
+  EXPECT_TRUE((*doc)["none"].isNull());
+  EXPECT_FALSE((*doc)["tags"][2]);
+  EXPECT_FALSE((*doc)["missing"]);
+  EXPECT_FALSE((*doc)["user"]["id"]["deeper"]);
+  // Wrong-type reads fail rather than converting.
+  EXPECT_FALSE((*doc)["user"]["name"].getInt64());
+  EXPECT_FALSE((*doc)["user"]["score"].getInt64());
+}
+
+TEST(OnDemandTest, CursorTest) {
+  std::string input = "{\"a\": 1, \"b\": 2, \"c\": 3}";
+  auto doc = ondemand::Document::fromString(input);
+  ASSERT_TRUE(doc);
+  const auto& root = doc->root();
+  EXPECT_EQ(root.findField("b").getInt64(), 2);
+  // findField never looks behind the cursor...
+  EXPECT_FALSE(root.findField("a"));
+  EXPECT_FALSE(root.findField("c"));
+
+  auto again = ondemand::Document::fromString(input);
+  const auto& wrapping = again->root();
+  EXPECT_EQ(wrapping["c"].getInt64(), 3);
+  // ...but operator[] wraps around to the start of the object.
+  EXPECT_EQ(wrapping["a"].getInt64(), 1);
+  EXPECT_EQ(wrapping["b"].getInt64(), 2);
+  EXPECT_FALSE(wrapping["d"]);
+  EXPECT_EQ(wrapping["c"].getInt64(), 3);
+}
+
+TEST(OnDemandTest, IterationTest) {
+  std::string input = "{\"k\\u0031\": [1, [2, 3], {\"x\": 4}], \"k2\": []}";
+  auto doc = ondemand::Document::fromString(input);
+  ASSERT_TRUE(doc);
+
+  std::vector<std::string> keys;
+  for (const auto& field : doc->root().fields()) {
+    ASSERT_TRUE(field.key());
+    keys.push_back(*field.key());
+  }
+  EXPECT_EQ(keys, (std::vector<std::string>{"k1", "k2"}));
+  EXPECT_EQ((*doc)["k1"][0].getInt64(), 1);
+
+  std::vector<std::string> elements;
+  for (auto element : (*doc)["k1"].elements()) {
+    elements.push_back(std::string(*element.getRawJson()));
+  }
+  EXPECT_EQ(elements, (std::vector<std::string>{"1", "[2, 3]", "{\"x\": 4}"}));
+
+  auto empty = (*doc)["k2"].elements();
+  EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(OnDemandTest, RejectTest) {
+  EXPECT_FALSE(ondemand::Document::fromString(""));
+  EXPECT_FALSE(ondemand::Document::fromString("  "));
+  EXPECT_FALSE(ondemand::Document::fromString("}"));
+
+  // Errors surface when the malformed part is read.
+  std::string input =
+      "{\"a\": 12abc, \"c\": \"caf\xC3\", \"b\": \"unterminated}";
+  auto doc = ondemand::Document::fromString(input);
+  ASSERT_TRUE(doc);
+  EXPECT_FALSE((*doc)["a"].getInt64());
+  EXPECT_FALSE((*doc)["c"].getString());
+  EXPECT_FALSE((*doc)["c"].getRawString());
+  EXPECT_FALSE((*doc)["b"].getString());
+
+  // ...including a key whose escapes decode to ill-formed text.
+  auto badKey = ondemand::Document::fromString("{\"\\n\xC3\": 1}");
+  ASSERT_TRUE(badKey);
+  auto fields = badKey->root().fields();
+  ASSERT_NE(fields.begin(), fields.end());
+  EXPECT_FALSE((*fields.begin()).key());
+
+  // An unpaired surrogate escape is malformed wherever it is read.
+  auto lone =
+      ondemand::Document::fromString("[\"\\uD800\", {\"\\uDC00\": 1}]");
+  ASSERT_TRUE(lone);
+  EXPECT_FALSE((*lone)[0].getString());
+  EXPECT_FALSE((*lone)[0].getRawString());
+  auto loneKeys = (*lone)[1].fields();
+  EXPECT_EQ(loneKeys.begin(), loneKeys.end());
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace jerry::test {
+// Valid documents that every parser must read to the same value as
+// Json::fromString. Suites that mirror the DOM instantiate from this list
+// with ::testing::ValuesIn and add only their own API's checks.
+inline const std::vector<std::string>& parseCorpus() {
+  static const std::vector<std::string> corpus = {
+      "[\"hello\", \"beautiful\", \"world\"]",
+      "{\"hey\" : \"dude\"}",
+      "true",
+      "false",
+      "null",
+      "{\"enable gamer mode?\" : true}",
+      "{\"NESTED json objects\" : {\"cowabunga\" : [\"surfs\",\"up\"]}}",
+      "123",
+      "-45",
+      "-45.67",
+      "9007199254740993",
+      "[9007199254740993, 1.5e2, -0]",
+      "[0.1, 1e300, -0, 5e-324]",
+      "[150.0, -0.0, 1e2, 150]",
+      "[1, 2, 3, 4]",
+      "{\"a\":1,\"b\":2}",
+      "{\"emptyArray\":[],\"emptyObject\":{}}",
+      "[{\"x\":1}, {\"y\":2}]",
+      "{\"nested\":[{\"a\":true}, {\"b\":false}]}",
+      "\"string with \\\"escaped quotes\\\"\"",
+      "\"\\u0001\\b\\f\\n\\r\\t\\\\ and a long tail past sixteen bytes\"",
+      "{\"unicode\":\"\\u263A\"}",
+      " [ \"\\\\\" , \"\\ud83d\\ude00\" ] ",
+      "\t{\n\t\"a\" :\r\n [1,\t2]\n}\r\n",
+  };
+  return corpus;
+}
+}  // namespace jerry::test
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PathQuery.h"
+
+using namespace jerry;
+using ondemand::PathQuery;
+
+namespace {
+std::vector<std::pair<size_t, std::string>> matches(
+    const PathQuery& query, std::string_view input) {
+  std::vector<std::pair<size_t, std::string>> out;
+  bool ok = query.run(input, [&out](size_t path, const ondemand::Value& v) {
+    auto json = v.toJsonValue();
+    out.emplace_back(path, json ? json->toString() : "invalid");
+    return true;
+  });
+  EXPECT_TRUE(ok);
+  return out;
+}
+}  // namespace
+
+TEST(PathQueryTest, ManyPathsTest) {
+  auto query = PathQuery::compile(
+      {"/user/id", "/items/*/price", "/items/1", "/user/name/first"});
+  ASSERT_TRUE(query);
+  EXPECT_EQ(query->size(), 4u);
+  std::string input = R"({"skip": {"user": {"id": 0}}, "user": {"id": 7,)"
+                      R"( "name": {"first": "Ada"}},)"
+                      R"( "items": [{"price": 1.5}, {"x": [], "price": 2},)"
+                      R"( {"price": "n/a"}]})";
+  std::vector<std::pair<size_t, std::string>> expected = {
+      {0, "7"},           {3, "\"Ada\""}, {1, "1.5"},
+      {2, R"({"x":[],"price":2})"},       {1, "2"},
+      {1, "\"n/a\""}};
+  EXPECT_EQ(matches(*query, input), expected);
+}
+
+TEST(PathQueryTest, SelectTest) {
+  auto query = PathQuery::compile({"/a", "/missing", "/b/*"});
+  ASSERT_TRUE(query);
+  auto selected = query->select(R"({"b": {"x": 1, "y": 2}, "a": true})");
+  ASSERT_TRUE(selected);
+  ASSERT_EQ(selected->size(), 3u);
+  ASSERT_EQ((*selected)[0].size(), 1u);
+  EXPECT_EQ((*selected)[0][0].getBool(), true);
+  EXPECT_TRUE((*selected)[1].empty());
+  ASSERT_EQ((*selected)[2].size(), 2u);
+  EXPECT_EQ((*selected)[2][1].getInt64(), 2);
+}
+
+TEST(PathQueryTest, EscapesTest) {
+  auto query = PathQuery::compile({"/a~1b", "/m~0n", "/"});
+  ASSERT_TRUE(query);
+  // Keys escaped in the input are decoded before they are compared.
+  std::string input = R"({"a/b": 1, "m~n": 2, "": 3, "a\/b": 4})";
+  std::vector<std::pair<size_t, std::string>> expected = {
+      {0, "1"}, {1, "2"}, {2, "3"}, {0, "4"}};
+  EXPECT_EQ(matches(*query, input), expected);
+}
+
+TEST(PathQueryTest, IndexOrKeyTest) {
+  auto query = PathQuery::compile({"/0", "/01"});
+  ASSERT_TRUE(query);
+  std::vector<std::pair<size_t, std::string>> array = {{0, "\"a\""}};
+  EXPECT_EQ(matches(*query, R"(["a", "b"])"), array);
+  std::vector<std::pair<size_t, std::string>> object = {{1, "1"}, {0, "2"}};
+  EXPECT_EQ(matches(*query, R"({"01": 1, "0": 2})"), object);
+}
+
+TEST(PathQueryTest, RootTest) {
+  auto query = PathQuery::compile({"", "/x"});
+  ASSERT_TRUE(query);
+  std::vector<std::pair<size_t, std::string>> expected = {
+      {0, R"({"x":[1]})"}, {1, "[1]"}};
+  EXPECT_EQ(matches(*query, R"( {"x": [1]} )"), expected);
+}
+
+TEST(PathQueryTest, EarlyStopTest) {
+  auto query = PathQuery::compile({"/*"});
+  ASSERT_TRUE(query);
+  size_t calls = 0;
+  // The scan ends at the first match, so the broken tail is never read.
+  EXPECT_TRUE(query->run("[1, 2, {", [&calls](size_t, const ondemand::Value&) {
+    calls++;
+    return false;
+  }));
+  EXPECT_EQ(calls, 1u);
+}
+
+TEST(PathQueryTest, InvalidPathTest) {
+  EXPECT_FALSE(PathQuery::compile({"a"}));
+  EXPECT_FALSE(PathQuery::compile({"/a", "/~2"}));
+  EXPECT_FALSE(PathQuery::compile({"/a~"}));
+}
+
+class PathQueryMalformedTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(PathQueryMalformedTest, MalformedTest) {
+  auto query = PathQuery::compile({"/a/b", "/c/*"});
+  ASSERT_TRUE(query);
+  EXPECT_FALSE(query->run(GetParam(), [](size_t, const ondemand::Value&) {
+    return true;
+  }));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  PathQueryMalformedTests, PathQueryMalformedTest,
+  ::testing::Values(
+    "",
+    "{",
+    "{\"a\": {\"b\": 1}",
+    "{\"a\" {\"b\": 1}}",
+    "{\"a\": {\"b\": 1,}}",
+    "{\"x\": [1, 2}",
+    "{\"c\": [1 2]}",
+    "{\"a\": 1} 2",
+    "{a: 1}"
+  )
+);
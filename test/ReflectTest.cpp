@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Reflect.h"
+
+namespace orders {
+enum class Side { buy, sell };
+JERRY_ENUM(Side, buy, sell)
+
+enum Priority : uint8_t { low = 1, high = 2 };
+
+struct Item {
+  std::string sku;
+  int32_t quantity = 0;
+};
+JERRY_FIELDS(Item, sku, quantity)
+
+struct Order {
+  int64_t id = 0;
+  double price = 0;
+  bool paid = false;
+  Side side = Side::buy;
+  Priority priority = low;
+  std::optional<std::string> note;
+  std::vector<Item> items;
+  std::vector<std::vector<int>> matrix;
+};
+JERRY_FIELDS(Order, id, price, paid, side, priority, note, items, matrix)
+
+struct Tree {
+  std::string name;
+  std::vector<Tree> children;
+};
+JERRY_FIELDS(Tree, name, children)
+}  // namespace orders
+
+using namespace jerry;
+using namespace orders;
+
+TEST(ReflectTest, OrderTest) {
+  auto order = parseInto<Order>(R"({
+    "id": 42, "price": 9.5, "paid": true, "side": "sell", "priority": 2,
+    "note": "leave at the door",
+    "items": [{"sku": "A-1", "quantity": 3}, {"quantity": 1, "sku": "B2"}],
+    "matrix": [[1, 2], [], [3]]
+  })");
+  ASSERT_TRUE(order);
+  EXPECT_EQ(order->id, 42);
+  EXPECT_EQ(order->price, 9.5);
+  EXPECT_TRUE(order->paid);
+  EXPECT_EQ(order->side, Side::sell);
+  EXPECT_EQ(order->priority, high);
+  EXPECT_EQ(order->note, "leave at the door");
+  ASSERT_EQ(order->items.size(), 2u);
+  EXPECT_EQ(order->items[0].sku, "A-1");
+  EXPECT_EQ(order->items[0].quantity, 3);
+  EXPECT_EQ(order->items[1].sku, "B2");
+  EXPECT_EQ(order->items[1].quantity, 1);
+  EXPECT_EQ(order->matrix,
+            (std::vector<std::vector<int>>{{1, 2}, {}, {3}}));
+}
+
+TEST(ReflectTest, MissingNullAndUnknownKeysTest) {
+  Order order;
+  order.note = "kept until null";
+  order.price = 1.25;
+  ASSERT_TRUE(parseInto(R"({"extra": {"deep": [1, {"x": "}"}]}, "id": 7,)"
+                        R"( "note": null, "also\"unknown": [], "id": 8})",
+                        order));
+  // The last of two equal keys wins.
+  EXPECT_EQ(order.id, 8);
+  EXPECT_EQ(order.price, 1.25);
+  EXPECT_FALSE(order.note);
+}
+
+TEST(ReflectTest, EscapedKeyTest) {
+  auto item = parseInto<Item>(R"({"s\u006bu": "C", "quantit\u0079": 5})");
+  ASSERT_TRUE(item);
+  EXPECT_EQ(item->sku, "C");
+  EXPECT_EQ(item->quantity, 5);
+}
+
+TEST(ReflectTest, RecursiveTest) {
+  auto tree = parseInto<Tree>(
+      R"({"name": "root", "children": [{"name": "a", "children": []},)"
+      R"( {"name": "b", "children": [{"name": "c", "children": []}]}]})");
+  ASSERT_TRUE(tree);
+  ASSERT_EQ(tree->children.size(), 2u);
+  EXPECT_EQ(tree->children[1].children[0].name, "c");
+}
+
+TEST(ReflectTest, KeyIndexTest) {
+  constexpr std::array<std::string_view, 5> names = {"id", "ix", "price",
+                                                     "prize", ""};
+  constexpr detail::KeyIndex<5> index(names);
+  static_assert(index.find("prize") == 3);
+  for (size_t i = 0; i < names.size(); i++) {
+    EXPECT_EQ(index.find(names[i]), i);
+  }
+  EXPECT_EQ(index.find("iy"), 5u);
+  EXPECT_EQ(index.find("pride"), 5u);
+}
+
+class ReflectRejectTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(ReflectRejectTest, RejectTest) {
+  EXPECT_FALSE(parseInto<Order>(GetParam()));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  ReflectRejectTests, ReflectRejectTest,
+  ::testing::Values(
+    "",
+    "[]",
+    "{\"id\": 1.5}",
+    "{\"id\": \"1\"}",
+    "{\"priority\": 1}x",
+    "{\"items\": [{\"quantity\": 3000000000}]}",
+    "{\"side\": \"hold\"}",
+    "{\"paid\": null}",
+    "{\"id\": 1,}",
+    "{\"items\": [{\"sku\": \"a\"},]}",
+    "{\"matrix\": [[1, 2]}",
+    "{\"id\" 1}",
+    "{\"extra\": [1, 2}",
+    "{\"id\": 1} {}"
+  )
+);
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "ParseCorpus.h"
+#include "Sax.h"
+
+using namespace jerry;
+
+namespace {
+// Records every event as a short string.
+struct RecordingHandler {
+  std::vector<std::string> events;
+  size_t stopAfter = static_cast<size_t>(-1);
+
+  bool record(std::string event) {
+    events.push_back(std::move(event));
+    return events.size() < stopAfter;
+  }
+
+  bool onObjectStart() { return record("{"); }
+  bool onObjectEnd() { return record("}"); }
+  bool onArrayStart() { return record("["); }
+  bool onArrayEnd() { return record("]"); }
+  bool onKey(std::string_view s) { return record("key:" + std::string(s)); }
+  bool onString(std::string_view s) { return record("str:" + std::string(s)); }
+  bool onNumber(int64_t n) { return record("int:" + std::to_string(n)); }
+  bool onNumber(double n) { return record("dbl:" + std::to_string(n)); }
+  bool onBool(bool b) { return record(b ? "true" : "false"); }
+  bool onNull() { return record("null"); }
+};
+}  // namespace
+
+class SaxParseTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(SaxParseTest, MatchesJsonTest) {
+  const auto& input = GetParam();
+  JsonValueHandler handler;
+  auto result = parseSax(input, handler);
+  auto json = Json::fromString(input);
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(result.position, input.size());
+  EXPECT_EQ(handler.getValue(), json->getValue());
+}
+
+INSTANTIATE_TEST_SUITE_P(SaxParseTests, SaxParseTest,
+                         ::testing::ValuesIn(test::parseCorpus()));
+
+TEST(SaxTest, EventOrderTest) {
+  RecordingHandler handler;
+  auto result =
+      parseSax("{\"a\": [1, 2.5, \"x\\ty\"], \"b\": {\"c\": null, \"d\": true}}",
+               handler);
+  EXPECT_EQ(result.status, SaxStatus::Complete);
+  EXPECT_EQ(handler.events,
+            (std::vector<std::string>{"{", "key:a", "[", "int:1", "dbl:2.500000",
+                                      "str:x\ty", "]", "key:b", "{", "key:c",
+                                      "null", "key:d", "true", "}", "}"}));
+}
+
+TEST(SaxTest, StopEarlyTest) {
+  RecordingHandler handler;
+  handler.stopAfter = 3;
+  std::string input = "[1, 2, 3, 4]";
+  auto result = parseSax(input, handler);
+  EXPECT_EQ(result.status, SaxStatus::Stopped);
+  EXPECT_FALSE(result);
+  EXPECT_EQ(handler.events, (std::vector<std::string>{"[", "int:1", "int:2"}));
+  EXPECT_LT(result.position, input.size());
+}
+
+TEST(SaxTest, ErrorTest) {
+  RecordingHandler handler;
+  auto result = parseSax("[1, 2,", handler);
+  EXPECT_EQ(result.status, SaxStatus::Error);
+  EXPECT_EQ(result.position, 6u);
+  EXPECT_EQ(parseSax("[1] 2", handler).status, SaxStatus::Error);
+}
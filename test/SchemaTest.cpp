@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Schema.h"
+
+using namespace jerry;
+
+namespace {
+using Fill = schema::Object<schema::Required<"qty", int32_t>,
+                            schema::Required<"px", double>>;
+
+using Trade = schema::Object<
+    schema::Required<"id", int64_t>,
+    schema::Required<"symbol", std::string>,
+    schema::Required<"price", double>,
+    schema::Required<"buy", bool>,
+    schema::Optional<"venue", std::string>,
+    schema::Optional<"a rather long key name", int64_t>,
+    schema::Required<"fills", std::vector<Fill>>>;
+
+const auto& trades() {
+  static const auto parser = schema::tokenizer<Trade>();
+  return parser;
+}
+}  // namespace
+
+TEST(SchemaTest, DeclaredOrderTest) {
+  std::string input =
+      R"({"id":7,"symbol":"ACME","price":12.5,"buy":true,"venue":"X",)"
+      R"("a rather long key name":-3,"fills":[{"qty":1,"px":12},{"qty":2,"px":13}]})";
+  auto result = trades().run(TokenizerState(input, 0));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(result->second.getPosition(), input.size());
+  const auto& trade = result->first;
+  EXPECT_EQ(trade.get<"id">(), 7);
+  EXPECT_EQ(trade.get<"symbol">(), "ACME");
+  EXPECT_EQ(trade.get<"price">(), 12.5);
+  EXPECT_TRUE(trade.get<"buy">());
+  EXPECT_EQ(trade.get<"venue">(), "X");
+  EXPECT_EQ(trade.get<"a rather long key name">(), -3);
+  ASSERT_EQ(trade.get<"fills">().size(), 2u);
+  EXPECT_EQ(trade.get<"fills">()[1].get<"qty">(), 2);
+  EXPECT_EQ(trade.get<"fills">()[1].get<"px">(), 13.0);
+}
+
+TEST(SchemaTest, ReorderedAndOptionalTest) {
+  // Out of order keys, whitespace, a null and a missing optional field.
+  std::string input = R"( { "fills" : [ ] , "buy" : false, "venue" : null,
+      "symbol": "ZA", "price": 1, "id": 9 } )";
+  auto result = trades().run(TokenizerState(input, 0));
+  ASSERT_TRUE(result);
+  const auto& trade = result->first;
+  EXPECT_EQ(trade.get<"id">(), 9);
+  EXPECT_EQ(trade.get<"symbol">(), "ZA");
+  EXPECT_FALSE(trade.get<"buy">());
+  EXPECT_FALSE(trade.get<"venue">());
+  EXPECT_FALSE(trade.get<"a rather long key name">());
+  EXPECT_TRUE(trade.get<"fills">().empty());
+}
+
+TEST(SchemaTest, KeyPatternTest) {
+  constexpr schema::detail::KeyPattern<3> key("px");
+  // Enough input for a whole-word compare, then right at the end.
+  EXPECT_TRUE(key.matches(R"(px"     :)", 0));
+  EXPECT_FALSE(key.matches(R"(py"     :)", 0));
+  EXPECT_FALSE(key.matches(R"(px2"    :)", 0));
+  EXPECT_TRUE(key.matches(R"("px")", 1));
+  EXPECT_FALSE(key.matches(R"("px)", 1));
+}
+
+TEST(SchemaTest, FallbackTest) {
+  auto parser = schema::orJson<Fill>();
+  std::string matching = R"({"qty": 5, "px": 1.5})";
+  auto record = parser.run(TokenizerState(matching, 0));
+  ASSERT_TRUE(record);
+  ASSERT_EQ(record->first.index(), 0u);
+  EXPECT_EQ(std::get<0>(record->first).get<"qty">(), 5);
+
+  std::string extraKey = R"({"qty": 5, "px": 1.5, "note": "late"})";
+  auto generic = parser.run(TokenizerState(extraKey, 0));
+  ASSERT_TRUE(generic);
+  ASSERT_EQ(generic->first.index(), 1u);
+  EXPECT_EQ(std::get<1>(generic->first),
+            JsonValue(JsonObject{{"qty", 5}, {"px", 1.5}, {"note", "late"}}));
+  EXPECT_EQ(generic->second.getPosition(), extraKey.size());
+
+  std::string broken = R"({"qty": 5,)";
+  EXPECT_FALSE(parser.run(TokenizerState(broken, 0)));
+}
+
+class SchemaMissTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(SchemaMissTest, MissTest) {
+  EXPECT_FALSE(schema::tokenizer<Fill>().run(TokenizerState(GetParam(), 0)));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  SchemaMissTests, SchemaMissTest,
+  ::testing::Values(
+    "",
+    "[]",
+    "{}",
+    "{\"qty\": 1}",
+    "{\"qty\": 1, \"px\": 2, \"qty\": 3}",
+    "{\"qty\": 1.5, \"px\": 2}",
+    "{\"qty\": 3000000000, \"px\": 2}",
+    "{\"qty\": \"1\", \"px\": 2}",
+    "{\"q\\u0074y\": 1, \"px\": 2}",
+    "{\"qty\": 1, \"px\": 2,}",
+    "{\"qty\": 1 \"px\": 2}",
+    "{\"qtyx\": 1, \"px\": 2}"
+  )
+);
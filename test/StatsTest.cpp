@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "Json.h"
+#include "Stats.h"
+#include "Tokenizer.h"
+
+using namespace jerry;
+
+class StatsTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    if (!kStatsEnabled) {
+      GTEST_SKIP() << "built without JERRY_STATS";
+    }
+    resetStats();
+  }
+};
+
+TEST(StatsDisabledTest, ZeroWithoutStatsTest) {
+  if (kStatsEnabled) {
+    GTEST_SKIP() << "built with JERRY_STATS";
+  }
+  auto json = Json::fromString(R"({"a":[1,"b",true,null]})");
+  ASSERT_TRUE(json);
+  Stats snapshot = stats();
+  for (const CombinatorStats& c : snapshot.combinators) {
+    EXPECT_EQ(c.invocations, 0u);
+  }
+  EXPECT_EQ(snapshot.closuresBuilt, 0u);
+  auto dump = Json::fromString(snapshot.toJson());
+  ASSERT_TRUE(dump);
+  JsonValue value = std::move(*dump).getValue();
+  auto& root = std::get<JsonObject>(value.value);
+  EXPECT_EQ(root.at("enabled"), JsonValue(false));
+}
+
+TEST_F(StatsTest, RunTest) {
+  auto tokenizer = expectString("true");
+  EXPECT_TRUE(tokenizer.run(TokenizerState("true", 0)));
+  EXPECT_FALSE(tokenizer.run(TokenizerState("false", 0)));
+  Stats snapshot = stats();
+  const CombinatorStats& c = snapshot[Combinator::ExpectString];
+  EXPECT_EQ(c.invocations, 2u);
+  EXPECT_EQ(c.failures, 1u);
+  EXPECT_EQ(c.bytesConsumed, 4u);
+}
+
+TEST_F(StatsTest, OrElseBacktrackTest) {
+  auto tokenizer = boolean();
+  EXPECT_TRUE(tokenizer.run(TokenizerState("false", 0)));
+  Stats snapshot = stats();
+  EXPECT_EQ(snapshot[Combinator::OrElse].invocations, 1u);
+  EXPECT_EQ(snapshot[Combinator::OrElse].backtracks, 1u);
+  // "true" was tried and failed, then "false" matched.
+  EXPECT_EQ(snapshot[Combinator::ExpectString].invocations, 2u);
+  EXPECT_EQ(snapshot[Combinator::ExpectString].failures, 1u);
+  EXPECT_EQ(snapshot[Combinator::Map].bytesConsumed, 5u);
+}
+
+TEST_F(StatsTest, BindBacktrackTest) {
+  auto pair = expectChar('a').bind<char>([](char) { return expectChar('b'); });
+  EXPECT_FALSE(pair.run(TokenizerState("ac", 0)));
+  Stats snapshot = stats();
+  const CombinatorStats& bind = snapshot[Combinator::Bind];
+  EXPECT_EQ(bind.failures, 1u);
+  EXPECT_EQ(bind.backtracks, 1u);
+  EXPECT_EQ(bind.backtrackedBytes, 1u);
+}
+
+TEST_F(StatsTest, ClosureAndCopyTest) {
+  Tokenizer<char> erased = character();
+  EXPECT_TRUE(erased.run(TokenizerState("x", 0)));
+  Stats snapshot = stats();
+  EXPECT_GE(snapshot.closuresBuilt, 2u);
+  EXPECT_GT(snapshot.stateCopies, 0u);
+  EXPECT_EQ(snapshot[Combinator::Erased].invocations, 1u);
+  EXPECT_EQ(snapshot[Combinator::Character].invocations, 1u);
+}
+
+TEST_F(StatsTest, ParseAndDumpTest) {
+  auto json = Json::fromString(R"({"a":[1,"b",true,null]})");
+  ASSERT_TRUE(json);
+  Stats snapshot = stats();
+  EXPECT_EQ(snapshot[Combinator::JsonNumber].invocations, 1u);
+  EXPECT_EQ(snapshot[Combinator::JsonString].invocations, 2u);
+  auto dump = Json::fromString(snapshot.toJson());
+  ASSERT_TRUE(dump);
+  JsonValue value = std::move(*dump).getValue();
+  auto& root = std::get<JsonObject>(value.value);
+  EXPECT_EQ(root.at("enabled"), JsonValue(true));
+  auto& combinators = std::get<JsonObject>(root.at("combinators").value);
+  auto& jsonString = std::get<JsonObject>(combinators.at("jsonString").value);
+  EXPECT_EQ(jsonString.at("invocations"), JsonValue(2));
+  resetStats();
+  EXPECT_EQ(stats()[Combinator::JsonString].invocations, 0u);
+}
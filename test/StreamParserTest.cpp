@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "ParseCorpus.h"
+#include "StreamParser.h"
+
+using namespace jerry;
+
+namespace {
+// Feeds input in chunks cut at the given offsets.
+SaxResult parseInChunks(std::string_view input,
+                        const std::vector<size_t>& cuts,
+                        JsonValueHandler& handler) {
+  StreamParser parser(handler);
+  size_t start = 0;
+  for (size_t cut : cuts) {
+    parser.feed(input.substr(start, cut - start));
+    start = cut;
+  }
+  parser.feed(input.substr(start));
+  return parser.finish();
+}
+}  // namespace
+
+class StreamParseTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(StreamParseTest, EverySplitMatchesJsonTest) {
+  const auto& input = GetParam();
+  auto json = Json::fromString(input);
+  ASSERT_TRUE(json);
+  for (size_t cut = 0; cut <= input.size(); cut++) {
+    JsonValueHandler handler;
+    auto result = parseInChunks(input, {cut}, handler);
+    ASSERT_EQ(result.status, SaxStatus::Complete) << "split at " << cut;
+    EXPECT_EQ(result.position, input.size());
+    EXPECT_EQ(handler.getValue(), json->getValue()) << "split at " << cut;
+  }
+}
+
+TEST_P(StreamParseTest, ByteAtATimeMatchesJsonTest) {
+  const auto& input = GetParam();
+  std::vector<size_t> cuts;
+  for (size_t i = 1; i < input.size(); i++) {
+    cuts.push_back(i);
+  }
+  JsonValueHandler handler;
+  auto result = parseInChunks(input, cuts, handler);
+  ASSERT_EQ(result.status, SaxStatus::Complete);
+  EXPECT_EQ(handler.getValue(), Json::fromString(input)->getValue());
+}
+
+INSTANTIATE_TEST_SUITE_P(StreamParseTests, StreamParseTest,
+                         ::testing::ValuesIn(test::parseCorpus()));
+
+class StreamRejectTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(StreamRejectTest, EverySplitRejects) {
+  const auto& input = GetParam();
+  for (size_t cut = 0; cut <= input.size(); cut++) {
+    JsonValueHandler handler;
+    EXPECT_EQ(parseInChunks(input, {cut}, handler).status, SaxStatus::Error)
+        << "split at " << cut;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(StreamRejectTests, StreamRejectTest,
+                         ::testing::Values("", "[1 2]", "[1,]", "{\"a\" 1}",
+                                           "{\"a\":1,}", "{1:2}",
+                                           "\"unterminated", "true false",
+                                           "[\"a\"x]", "]", "tru", "[1}",
+                                           "\"bad \\x escape\""));
+
+TEST(StreamParserTest, EventsArriveBeforeTheEndTest) {
+  JsonValueHandler handler;
+  StreamParser parser(handler);
+  EXPECT_TRUE(parser.feed(std::string_view("[\"first\", {\"a\": [1")));
+  // The trailing "1" is buffered until the next chunk shows it has ended.
+  EXPECT_EQ(parser.position(), 18u);
+  EXPECT_TRUE(parser.feed(std::string_view("2]}]")));
+  auto result = parser.finish();
+  EXPECT_TRUE(result);
+  EXPECT_EQ(handler.getValue(),
+            JsonValue(std::vector<JsonValue>{
+                "first", JsonValue(JsonObject{
+                             {"a", JsonValue(std::vector<JsonValue>{12})}})}));
+}
+
+TEST(StreamParserTest, StopEarlyTest) {
+  struct FirstString : JsonValueHandler {
+    bool onString(std::string_view) { return false; }
+  } handler;
+  StreamParser parser(handler);
+  EXPECT_FALSE(parser.feed(std::string_view("[1, \"stop\", 3]")));
+  EXPECT_FALSE(parser.feed(std::string_view("more")));
+  EXPECT_EQ(parser.finish().status, SaxStatus::Stopped);
+}
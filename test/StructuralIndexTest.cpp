@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "StructuralIndex.h"
+
+using namespace jerry;
+
+static std::vector<uint32_t> positionsOf(const std::string& input,
+                                         StructuralIndex::Implementation impl) {
+  auto index = StructuralIndex::build(input, impl);
+  EXPECT_TRUE(index);
+  return index ? index->getPositions() : std::vector<uint32_t>{};
+}
+
+class StructuralIndexTest
+    : public ::testing::TestWithParam<StructuralIndex::Implementation> {};
+
+TEST_P(StructuralIndexTest, SimpleDocumentTest) {
+  std::string input = "{\"a\" : [1, true, \"x,y\"]}";
+  std::vector<uint32_t> expected = {0, 1, 5, 7, 8, 9, 11, 15, 17, 22, 23};
+  EXPECT_EQ(positionsOf(input, GetParam()), expected);
+}
+
+TEST_P(StructuralIndexTest, EscapedQuoteTest) {
+  // The escaped quote does not end the string, the escaped backslash before
+  // the last quote does not escape it.
+  std::string input = "[\"a\\\"b\", \"c\\\\\"]";
+  std::vector<uint32_t> expected = {0, 1, 7, 9, 14};
+  EXPECT_EQ(positionsOf(input, GetParam()), expected);
+}
+
+TEST_P(StructuralIndexTest, CrossesBlockBoundaryTest) {
+  // Backslash as the last byte of the first block escapes the first byte of
+  // the second block.
+  std::string input = "[\"" + std::string(61, 'a') + "\\\"" +
+                      std::string(70, 'b') + "\", 12345]";
+  std::vector<uint32_t> expected = {
+      0, 1, static_cast<uint32_t>(input.size() - 8),
+      static_cast<uint32_t>(input.size() - 6),
+      static_cast<uint32_t>(input.size() - 1)};
+  EXPECT_EQ(input[63], '\\');
+  EXPECT_EQ(positionsOf(input, GetParam()), expected);
+}
+
+TEST_P(StructuralIndexTest, UnterminatedStringTest) {
+  EXPECT_FALSE(StructuralIndex::build("[\"abc]", GetParam()));
+  EXPECT_FALSE(StructuralIndex::build("[\"abc\\\"]", GetParam()));
+}
+
+TEST_P(StructuralIndexTest, MatchesScalarImplementationTest) {
+  std::string input;
+  for (int i = 0; i < 200; i++) {
+    input += "{\"key" + std::to_string(i) + "\":[" + std::to_string(i * 7) +
+             ",\"v\\\\\\\"" + std::string(i % 13, 'z') + "\",null],\t\"k\":\n" +
+             (i % 2 ? "false" : "-1.5e3") + "}\r\n";
+  }
+  EXPECT_EQ(positionsOf(input, GetParam()),
+            positionsOf(input, StructuralIndex::Implementation::Scalar));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Implementations, StructuralIndexTest,
+    ::testing::Values(StructuralIndex::Implementation::Scalar,
+                      StructuralIndex::Implementation::SSE2,
+                      StructuralIndex::Implementation::AVX2));
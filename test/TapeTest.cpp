@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "ParseCorpus.h"
+#include "Tape.h"
+
+using namespace jerry;
+
+class TapeParseTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(TapeParseTest, MatchesJsonTest) {
+  const auto& input = GetParam();
+  auto tape = Tape::fromString(input);
+  auto json = Json::fromString(input);
+  ASSERT_TRUE(tape);
+  ASSERT_TRUE(json);
+  EXPECT_EQ(tape->root().toJsonValue(), json->getValue());
+}
+
+INSTANTIATE_TEST_SUITE_P(TapeParseTests, TapeParseTest,
+                         ::testing::ValuesIn(test::parseCorpus()));
+
+TEST(TapeTest, LayoutTest) {
+  std::string input = "[1, {\"a\": \"b\"}, 2.5]";
+  auto tape = Tape::fromString(input);
+  ASSERT_TRUE(tape);
+  const auto& entries = tape->getEntries();
+  // [ int(2) { "a"(2) "b"(2) } double(2) ]
+  ASSERT_EQ(entries.size(), 12u);
+  EXPECT_EQ(Tape::typeOf(entries[0]), TapeType::ArrayStart);
+  EXPECT_EQ(Tape::payloadOf(entries[0]), 11u);
+  EXPECT_EQ(Tape::typeOf(entries[3]), TapeType::ObjectStart);
+  EXPECT_EQ(Tape::payloadOf(entries[3]), 8u);
+  EXPECT_EQ(Tape::typeOf(entries[8]), TapeType::ObjectEnd);
+  EXPECT_EQ(Tape::payloadOf(entries[8]), 3u);
+  EXPECT_EQ(Tape::typeOf(entries[11]), TapeType::ArrayEnd);
+
+  // Skipping the object jumps straight past its end entry.
+  auto object = tape->root()[1];
+  EXPECT_TRUE(object.isObject());
+  EXPECT_EQ(object.skip(), 9u);
+  EXPECT_EQ(object.nextSibling().getDouble(), 2.5);
+}
+
+TEST(TapeTest, AccessorTest) {
+  std::string input =
+      "{\"id\": 42, \"name\": \"jerry\", \"tags\": [\"a\", \"b\"], "
+      "\"esc\": \"x\\ny\", \"ok\": true, \"none\": null}";
+  auto tape = Tape::fromString(input);
+  ASSERT_TRUE(tape);
+  auto root = tape->root();
+  EXPECT_EQ(root.size(), 6u);
+  EXPECT_EQ(root["id"].getInt64(), 42);
+  EXPECT_EQ(root["name"].getString(), "jerry");
+  EXPECT_EQ(root["tags"].size(), 2u);
+  EXPECT_EQ(root["tags"][1].getString(), "b");
+  EXPECT_EQ(root["ok"].getBool(), true);
+  EXPECT_TRUE(root["none"].isNull());
+  EXPECT_FALSE(root["missing"]);
+  EXPECT_FALSE(root["tags"][2]);
+
+  // Unescaped strings are views into the source; escaped ones are decoded.
+  auto name = root["name"].getRawString();
+  ASSERT_TRUE(name);
+  EXPECT_GE(name->data(), input.data());
+  EXPECT_LT(name->data(), input.data() + input.size());
+  EXPECT_TRUE(root["esc"].hasEscapes());
+  EXPECT_EQ(root["esc"].getRawString(), "x\\ny");
+  EXPECT_EQ(root["esc"].getString(), "x\ny");
+}
+
+TEST(TapeTest, RejectTest) {
+  EXPECT_FALSE(Tape::fromString("[1 2]"));
+  EXPECT_FALSE(Tape::fromString("{\"a\":}"));
+  EXPECT_FALSE(Tape::fromString("\"bad \\x escape\""));
+  EXPECT_FALSE(Tape::fromString(""));
+  // Surrogates must come in escaped high-low pairs, as for Json::fromString.
+  EXPECT_FALSE(Tape::fromString("{\"\\uD800\":1}"));
+  EXPECT_FALSE(Tape::fromString("\"\\uDE00\""));
+  EXPECT_FALSE(Tape::fromString("\"\\uD83D\\u0041\""));
+  EXPECT_TRUE(Tape::fromString("\"\\uD83D\\uDE00\""));
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "ThreadPool.h"
+
+using namespace jerry;
+
+TEST(ThreadPoolTest, RunsEveryTaskTest) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+    for (int i = 0; i < 1000; i++) {
+      pool.submit([&count, &pool] {
+        count++;
+        // Tasks submitted from a worker land on its own deque.
+        pool.submit([&count] { count++; });
+      });
+    }
+  }
+  EXPECT_EQ(count, 2000);
+}
+
+TEST(ThreadPoolTest, BoundedQueueTest) {
+  BoundedQueue<int> queue(2);
+  std::thread producer([&queue] {
+    for (int i = 0; i < 100; i++) {
+      queue.push(i);
+    }
+    queue.close();
+  });
+  int expected = 0;
+  while (auto item = queue.pop()) {
+    EXPECT_EQ(*item, expected++);
+  }
+  producer.join();
+  EXPECT_EQ(expected, 100);
+}
+
+TEST(ThreadPoolTest, RunPendingTaskTest) {
+  ThreadPool pool(1);
+  BoundedQueue<int> result(1);
+  pool.submit([&] {
+    // The only worker is busy here, so the inner task only runs if this
+    // thread runs it.
+    bool ran = false;
+    pool.submit([&ran] { ran = true; });
+    while (!ran && pool.runPendingTask()) {
+    }
+    result.push(ran ? 1 : 0);
+  });
+  EXPECT_EQ(result.pop(), 1);
+  EXPECT_FALSE(pool.runPendingTask());
+}
@@ -40,3 +40,15 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple("{\"message\": \"hello world\"}", 2, 'm'),
         std::make_tuple("{\"message\": \"hello world\"}", 12, '"'),
         std::make_tuple("{\"message\": \"hello world\"}", 25, '}')));
+
+TEST(TokenizerStateViewTest, AdvanceSharesInputBuffer) {
+  std::string input = "{\"message\": \"hello world\"}";
+  auto state = jerry::TokenizerState::init(input, 0);
+  for (size_t i = 0; i < input.size() - 1; i++) {
+    state = state.advance();
+  }
+  // Advancing moves the cursor without copying the underlying buffer.
+  EXPECT_EQ(state.getInputString().data(), input.data());
+  EXPECT_EQ(state.getPosition(), input.size() - 1);
+  EXPECT_EQ(state.currentCharacter(), '}');
+}
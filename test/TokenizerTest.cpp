@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <iostream>
 
 #include "Tokenizer.h"
@@ -191,4 +192,133 @@ INSTANTIATE_TEST_SUITE_P(
     JsonNumberTests, JsonNumberTest,
     ::testing::Values(std::make_tuple("320", JsonToken::fromNumber(320)),
                       std::make_tuple("445.56",
-                                      JsonToken::fromNumber(445.56))));
+                                      JsonToken::fromNumber(445.56)),
+                      std::make_tuple("-45.67", JsonToken::fromNumber(-45.67)),
+                      std::make_tuple("0.1", JsonToken::fromNumber(0.1)),
+                      std::make_tuple("1e3", JsonToken::fromNumber(1000)),
+                      std::make_tuple("2.5E-3", JsonToken::fromNumber(0.0025)),
+                      std::make_tuple("-1.5e+2", JsonToken::fromNumber(-150)),
+                      std::make_tuple("123456789012345678",
+                                      JsonToken::fromInteger(
+                                          123456789012345678)),
+                      std::make_tuple("9007199254740993",
+                                      JsonToken::fromInteger(
+                                          9007199254740993)),
+                      std::make_tuple("-9223372036854775808",
+                                      JsonToken::fromInteger(
+                                          INT64_MIN)),
+                      std::make_tuple("9223372036854775808",
+                                      JsonToken::fromNumber(
+                                          9223372036854775808.0)),
+                      std::make_tuple("1e-400", JsonToken::fromNumber(0)),
+                      std::make_tuple("3.141592653589793238462643383279",
+                                      JsonToken::fromNumber(
+                                          3.141592653589793))));
+
+TEST(TokenizerTest, IntegerStaysExactTest) {
+  // 2^53 + 1 is not representable as a double.
+  auto r = jsonNumber().run(TokenizerState::init("9007199254740993", 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first.toInteger(), 9007199254740993);
+  EXPECT_NE(r->first, JsonToken::fromInteger(9007199254740992));
+  EXPECT_NE(r->first, JsonToken::fromNumber(9007199254740992.0));
+}
+
+TEST(TokenizerTest, NegativeZeroTest) {
+  auto r = jsonNumber().run(TokenizerState::init("-0", 0));
+  ASSERT_TRUE(r);
+  ASSERT_FALSE(r->first.toInteger());
+  EXPECT_TRUE(std::signbit(*r->first.toNumber()));
+}
+
+TEST(TokenizerTest, NumberStopsAtDelimiterTest) {
+  auto r = jsonNumber().run(TokenizerState::init("0123", 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, JsonToken::fromInteger(0));
+  EXPECT_EQ(r->second.getPosition(), 1);
+
+  r = jsonNumber().run(TokenizerState::init("12345678901,", 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, JsonToken::fromInteger(12345678901));
+  EXPECT_EQ(r->second.getPosition(), 11);
+}
+
+class JsonNumberRejectTest : public ::testing::TestWithParam<std::string> {};
+TEST_P(JsonNumberRejectTest, RejectTest) {
+  EXPECT_FALSE(jsonNumber().run(TokenizerState::init(GetParam(), 0)));
+}
+INSTANTIATE_TEST_SUITE_P(
+    JsonNumberRejectTests, JsonNumberRejectTest,
+    ::testing::Values("-", "+1", ".5", "1.", "1.e3", "1e", "1e+", "-a",
+                      "1e400"));
+
+TEST(TokenizerTest, StaticBindDeducesTypeTest) {
+  std::string input = "42";
+  // No explicit template arguments: the result type comes from the lambda.
+  auto twoDigits = digit().bind([](uint tens) {
+    return digit().map([tens](uint ones) { return tens * 10 + ones; });
+  });
+  auto r = twoDigits.run(TokenizerState::init(input, 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, 42u);
+  EXPECT_EQ(r->second.getPosition(), 2);
+}
+
+TEST(TokenizerTest, EraseTest) {
+  std::string input = "{}";
+  Tokenizer<JsonToken> erased = orElse(objectStart(), objectEnd()).erase();
+  std::vector<Tokenizer<JsonToken>> grammars = {erased, arrayStart()};
+  auto r = grammars[0].run(TokenizerState::init(input, 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, JsonToken::makeStructural(JsonTokenType::ObjectStart));
+  EXPECT_FALSE(grammars[1].run(r->second));
+}
+
+TEST(TokenizerTest, SkipManyTest) {
+  std::string input = "   x";
+  auto r = skipMany(whitespace()).run(TokenizerState::init(input, 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, 3u);
+  EXPECT_EQ(r->second.currentCharacter(), 'x');
+}
+
+TEST(TokenizerTest, WhitespaceTest) {
+  std::string input = " \t\r\n\vx";
+  auto r = skipMany(whitespace()).run(TokenizerState::init(input, 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, 4u);
+  EXPECT_EQ(r->second.currentCharacter(), '\v');
+}
+
+class JsonStringTest
+    : public ::testing::TestWithParam<std::tuple<std::string, std::string>> {};
+TEST_P(JsonStringTest, StringTest) {
+  const auto& [input, expected] = GetParam();
+  auto r = jsonString().run(TokenizerState::init(input, 0));
+  ASSERT_TRUE(r);
+  EXPECT_EQ(r->first, JsonToken::fromString(expected));
+  EXPECT_EQ(r->second.getPosition(), input.size());
+}
+INSTANTIATE_TEST_SUITE_P(
+    JsonStringTests, JsonStringTest,
+    ::testing::Values(
+        std::make_tuple("\"\"", ""),
+        std::make_tuple("\"hello\"", "hello"),
+        std::make_tuple("\"a long string that spans more than one chunk\"",
+                        "a long string that spans more than one chunk"),
+        std::make_tuple("\"say \\\"hi\\\"\"", "say \"hi\""),
+        std::make_tuple("\"\\\\\\/\\b\\f\\n\\r\\t\"", "\\/\b\f\n\r\t"),
+        std::make_tuple("\"\\u0041\\u00e9\\u263A\"", "A\u00e9\u263A"),
+        std::make_tuple("\"\\uD83D\\uDE00 grin\"", "\U0001F600 grin"),
+        std::make_tuple("\"0123456789abcdef0123456789\\n0123456789abcdef\"",
+                        "0123456789abcdef0123456789\n0123456789abcdef")));
+
+class JsonStringRejectTest : public ::testing::TestWithParam<std::string> {};
+TEST_P(JsonStringRejectTest, RejectTest) {
+  EXPECT_FALSE(jsonString().run(TokenizerState::init(GetParam(), 0)));
+}
+INSTANTIATE_TEST_SUITE_P(
+    JsonStringRejectTests, JsonStringRejectTest,
+    ::testing::Values("\"unterminated", "\"bad \\x escape\"",
+                      "\"raw\nnewline\"", "\"\\u12\"",
+                      "\"\\uD83D alone\"", "\"\\uDE00\"", "\"trailing\\"));
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+
+#include "Utf8.h"
+
+using namespace jerry;
+
+class Utf8Test : public ::testing::TestWithParam<utf8::Implementation> {};
+
+TEST_P(Utf8Test, ValidTest) {
+  std::string text =
+      "ASCII, caf\xC3\xA9, \xE2\x98\xBA, \xE6\x97\xA5\xE6\x9C\xAC,"
+      " \xF0\x9F\x98\x80, \xEF\xBF\xBF, \xF4\x8F\xBF\xBF, \x7F";
+  // Every alignment against the 64-byte blocks.
+  for (size_t pad = 0; pad < 130; pad++) {
+    std::string input = std::string(pad, 'x') + text + text;
+    EXPECT_EQ(utf8::findInvalid(input, GetParam()), input.size()) << pad;
+  }
+}
+
+TEST_P(Utf8Test, InvalidTest) {
+  // Each case: the bytes, and the offset of the first bad sequence in them.
+  const std::tuple<std::string, size_t> cases[] = {
+      {"\x80", 0},
+      {"ab\xBF", 2},
+      {"\xC0\x80", 0},
+      {"\xC1\xBF", 0},
+      {"\xE0\x80\x80", 0},
+      {"\xE0\x9F\xBF", 0},
+      {"\xED\xA0\x80", 0},
+      {"\xED\xBF\xBF", 0},
+      {"\xF0\x80\x80\x80", 0},
+      {"\xF0\x8F\xBF\xBF", 0},
+      {"\xF4\x90\x80\x80", 0},
+      {"\xF5\x80\x80\x80", 0},
+      {"\xFF", 0},
+      {"\xC3\xA9\xC3", 2},
+      {"\xE2\x98", 0},
+      {"\xE2\x98x", 0},
+      {"\xF0\x9F\x98", 0},
+      {"\xC3\xC3\xA9", 0},
+      {"\xE2\x98\xBA\xBA", 3},
+  };
+  for (const auto& [bytes, offset] : cases) {
+    for (size_t pad : {0, 1, 31, 61, 62, 63, 64, 100}) {
+      std::string input = std::string(pad, 'x') + bytes + std::string(70, 'y');
+      EXPECT_EQ(utf8::findInvalid(input, GetParam()), pad + offset)
+          << pad << " " << offset;
+      // Also when the input ends right after the bad sequence.
+      std::string tail = std::string(pad, 'x') + bytes;
+      EXPECT_EQ(utf8::findInvalid(tail, GetParam()), pad + offset);
+    }
+  }
+}
+
+TEST_P(Utf8Test, MatchesScalarImplementationTest) {
+  const std::string pieces[] = {"a",  "\xC3\xA9", "\xE2\x98\xBA",
+                                "\xF0\x9F\x98\x80", "\x80", "\xC3",
+                                "\xED\xA0\x80",     "\xF4\x90\x80\x80"};
+  std::mt19937 random(7);
+  for (int round = 0; round < 2000; round++) {
+    std::string input;
+    size_t length = random() % 300;
+    while (input.size() < length) {
+      // Mostly well-formed, so errors land anywhere in the input.
+      size_t piece = random() % 64 == 0 ? 4 + random() % 4 : random() % 4;
+      input += pieces[piece];
+    }
+    EXPECT_EQ(utf8::findInvalid(input, GetParam()),
+              utf8::findInvalid(input, utf8::Implementation::Scalar))
+        << round;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Implementations, Utf8Test,
+                         ::testing::Values(utf8::Implementation::Scalar,
+                                           utf8::Implementation::SSSE3,
+                                           utf8::Implementation::AVX2));
+
+TEST(Utf8ReplaceTest, MaximalSubpartTest) {
+  // One U+FFFD per maximal ill-formed subpart (Unicode 3.9, table 3-8).
+  const std::string fffd = "\xEF\xBF\xBD";
+  EXPECT_EQ(utf8::replaceInvalid("caf\xC3\xA9"), "caf\xC3\xA9");
+  EXPECT_EQ(utf8::replaceInvalid("a\xF0\x9F\x98" "b"), "a" + fffd + "b");
+  EXPECT_EQ(utf8::replaceInvalid("\xC0\x80"), fffd + fffd);
+  EXPECT_EQ(utf8::replaceInvalid("\xED\xA0\x80"), fffd + fffd + fffd);
+  EXPECT_EQ(utf8::replaceInvalid("\xE2\x98"), fffd);
+  EXPECT_EQ(utf8::replaceInvalid("\"\xE2\x98\""), "\"" + fffd + "\"");
+}
+
+TEST(Utf8ReplaceTest, IsValidTest) {
+  EXPECT_TRUE(utf8::isValid(""));
+  EXPECT_TRUE(utf8::isValid("plain ascii, longer than a word"));
+  EXPECT_TRUE(utf8::isValid("ascii first, then caf\xC3\xA9"));
+  EXPECT_FALSE(utf8::isValid("ascii first, then \xC3"));
+  EXPECT_FALSE(utf8::isValid("\xC3"));
+}
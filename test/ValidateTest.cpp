@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+
+#include "Json.h"
+#include "Validate.h"
+
+using namespace jerry;
+
+class ValidateAcceptTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(ValidateAcceptTest, AcceptTest) {
+  auto result = validate(GetParam());
+  EXPECT_TRUE(result) << validationErrorName(result.error) << " at "
+                      << result.offset;
+  EXPECT_EQ(result.offset, GetParam().size());
+  // Whatever validates must also parse.
+  EXPECT_TRUE(Json::fromString(GetParam()));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  ValidateAcceptTests, ValidateAcceptTest,
+  ::testing::Values(
+    "0",
+    "-0.0e+0",
+    "\t{\n\t\"a\" :\r\n [1,\t2]\n}\r\n",
+    "[\"hello\", \"beautiful\", \"world\"]",
+    "{\"NESTED json objects\" : {\"cowabunga\" : [\"surfs\",\"up\"]}}",
+    "{\"emptyArray\":[],\"emptyObject\":{}}",
+    "[true, false, null]",
+    "\"\\\" \\\\ \\/ \\b \\f \\n \\r \\t \\u263A \\uD83D\\uDE00\"",
+    "\"a string longer than sixteen bytes, \\u00e9 and raw \xc3\xa9\"",
+    "[9007199254740993, 1.5e2, -45.67, 1E-400, 0e999, 0.000e999]",
+    "\"caf\xC3\xA9 \xF0\x9F\x98\x80\"",
+    "1.7976931348623157e308",
+    "-17976931348623157e292"
+  )
+);
+
+class ValidateRejectTest
+    : public ::testing::TestWithParam<
+          std::tuple<std::string, ValidationError, size_t>> {};
+
+TEST_P(ValidateRejectTest, RejectTest) {
+  const auto& [input, error, offset] = GetParam();
+  auto result = validate(input);
+  EXPECT_FALSE(result);
+  EXPECT_EQ(result.error, error) << validationErrorName(result.error);
+  EXPECT_EQ(result.offset, offset);
+  // Whatever fails to validate must also fail to parse.
+  EXPECT_FALSE(Json::fromString(input));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  ValidateRejectTests, ValidateRejectTest,
+  ::testing::Values(
+    std::make_tuple("", ValidationError::UnexpectedEnd, 0),
+    std::make_tuple(" \n ", ValidationError::UnexpectedEnd, 3),
+    std::make_tuple("[1, 2", ValidationError::UnexpectedEnd, 5),
+    std::make_tuple("{\"a\": \"b", ValidationError::UnexpectedEnd, 8),
+    std::make_tuple("[1 2]", ValidationError::UnexpectedCharacter, 3),
+    std::make_tuple("[1,]", ValidationError::UnexpectedCharacter, 3),
+    std::make_tuple("{\"a\" 1}", ValidationError::UnexpectedCharacter, 5),
+    std::make_tuple("{a: 1}", ValidationError::UnexpectedCharacter, 1),
+    std::make_tuple("{\"a\": 1]", ValidationError::UnexpectedCharacter, 7),
+    std::make_tuple("\v1", ValidationError::UnexpectedCharacter, 0),
+    std::make_tuple("\"tab\there\"", ValidationError::ControlCharacter, 4),
+    std::make_tuple("\"\xC3\"", ValidationError::InvalidUtf8, 1),
+    std::make_tuple("[\"ab\\n\xED\xA0\x80\"]", ValidationError::InvalidUtf8, 6),
+    std::make_tuple("\"\xE2\x98\\n\"", ValidationError::InvalidUtf8, 1),
+    std::make_tuple("\"\\x\"", ValidationError::InvalidEscape, 1),
+    std::make_tuple("\"\\u12G4\"", ValidationError::InvalidEscape, 1),
+    std::make_tuple("\"\\uDE00\"", ValidationError::InvalidEscape, 1),
+    std::make_tuple("\"\\uD83D\\n\"", ValidationError::InvalidEscape, 1),
+    std::make_tuple("\"\\uD83D\\u0041\"", ValidationError::InvalidEscape, 1),
+    std::make_tuple("01", ValidationError::TrailingContent, 1),
+    std::make_tuple("[-]", ValidationError::InvalidNumber, 2),
+    std::make_tuple("[1.]", ValidationError::InvalidNumber, 3),
+    std::make_tuple("[1e+]", ValidationError::InvalidNumber, 4),
+    std::make_tuple("[.5]", ValidationError::UnexpectedCharacter, 1),
+    std::make_tuple("[1, 1e309]", ValidationError::InvalidNumber, 4),
+    std::make_tuple("1.8e308", ValidationError::InvalidNumber, 0),
+    std::make_tuple("-0.001e312", ValidationError::InvalidNumber, 0),
+    std::make_tuple("[tru]", ValidationError::InvalidLiteral, 4),
+    std::make_tuple("nul", ValidationError::UnexpectedEnd, 3),
+    std::make_tuple("{} {}", ValidationError::TrailingContent, 3)
+  )
+);
+
+TEST(ValidateTest, DepthTest) {
+  std::string deepest = std::string(kMaxValidationDepth, '[') +
+                        std::string(kMaxValidationDepth, ']');
+  EXPECT_TRUE(validate(deepest));
+
+  std::string tooDeep = std::string(kMaxValidationDepth + 1, '[') +
+                        std::string(kMaxValidationDepth + 1, ']');
+  auto result = validate(tooDeep);
+  EXPECT_EQ(result.error, ValidationError::TooDeep);
+  EXPECT_EQ(result.offset, kMaxValidationDepth);
+}
+
+TEST(ValidateTest, ErrorNameTest) {
+  EXPECT_EQ(validationErrorName(ValidationError::None), "none");
+  EXPECT_EQ(validationErrorName(ValidationError::TrailingContent),
+            "trailingContent");
+}
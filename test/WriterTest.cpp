@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <variant>
+
+#include "ParseCorpus.h"
+#include "Sax.h"
+#include "Writer.h"
+
+using namespace jerry;
+
+namespace {
+// Equal with every number of the same alternative (int64_t or double) and,
+// for doubles, the same sign, which operator== does not check.
+bool sameRepresentation(const JsonValue& a, const JsonValue& b) {
+  if (a.value.index() != b.value.index()) {
+    return false;
+  }
+  if (auto* d = std::get_if<double>(&a.value)) {
+    double other = std::get<double>(b.value);
+    return *d == other && std::signbit(*d) == std::signbit(other);
+  }
+  if (auto* v = std::get_if<std::vector<JsonValue>>(&a.value)) {
+    const auto& w = std::get<std::vector<JsonValue>>(b.value);
+    return std::equal(v->begin(), v->end(), w.begin(), w.end(),
+                      sameRepresentation);
+  }
+  if (auto* o = std::get_if<JsonObject>(&a.value)) {
+    const auto& p = std::get<JsonObject>(b.value);
+    return std::equal(o->begin(), o->end(), p.begin(), p.end(),
+                      [](const auto& x, const auto& y) {
+                        return x.first == y.first &&
+                               sameRepresentation(x.second, y.second);
+                      });
+  }
+  return a == b;
+}
+}  // namespace
+
+class WriterRoundTripTest : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(WriterRoundTripTest, RoundTripTest) {
+  auto json = Json::fromString(GetParam());
+  ASSERT_TRUE(json);
+  for (bool pretty : {false, true}) {
+    std::string text = toJson(json->getValue(), {.pretty = pretty});
+    auto reparsed = Json::fromString(text);
+    ASSERT_TRUE(reparsed) << text;
+    EXPECT_EQ(reparsed, json) << text;
+    EXPECT_TRUE(sameRepresentation(reparsed->getValue(), json->getValue()))
+        << text;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(WriterRoundTripTests, WriterRoundTripTest,
+                         ::testing::ValuesIn(test::parseCorpus()));
+
+TEST(WriterTest, CompactTest) {
+  EXPECT_EQ(toJson(JsonValue(std::vector<JsonValue>{
+                1, 2.5, "a\"b", true, JsonValue(),
+                JsonValue(std::vector<JsonValue>{})})),
+            "[1,2.5,\"a\\\"b\",true,null,[]]");
+  EXPECT_EQ(toJson(JsonValue(0.1)), "0.1");
+  EXPECT_EQ(toJson(JsonValue(150.0)), "150.0");
+  EXPECT_EQ(toJson(JsonValue(-0.0)), "-0.0");
+  EXPECT_EQ(toJson(JsonValue(1e300)), "1e+300");
+  EXPECT_EQ(toJson(JsonValue(std::string("\x1f", 1))), "\"\\u001f\"");
+  EXPECT_EQ(toJson(JsonValue(std::numeric_limits<double>::infinity())),
+            "null");
+  EXPECT_EQ(toJson(JsonValue(NAN)), "null");
+  EXPECT_EQ(JsonValue(std::vector<JsonValue>{1, 2}).toString(), "[1,2]");
+}
+
+TEST(WriterTest, PrettyTest) {
+  auto json = Json::fromString("{\"a\": [1, {}, []]}");
+  ASSERT_TRUE(json);
+  EXPECT_EQ(toJson(json->getValue(), {.pretty = true}),
+            "{\n  \"a\": [\n    1,\n    {},\n    []\n  ]\n}");
+}
+
+TEST(WriterTest, SinkTest) {
+  std::vector<JsonValue> values;
+  for (int i = 0; i < 20000; i++) {
+    values.push_back(JsonValue("value " + std::to_string(i)));
+  }
+  JsonValue value(std::move(values));
+  std::string collected;
+  size_t chunks = 0;
+  {
+    Writer writer([&](std::string_view chunk) {
+      collected.append(chunk);
+      chunks++;
+    });
+    writer.write(value);
+  }
+  EXPECT_GT(chunks, 1u);
+  EXPECT_EQ(collected, toJson(value));
+}
+
+TEST(WriterTest, SaxReEmitTest) {
+  std::string out;
+  Writer writer(out);
+  auto result = parseSax("[1, {\"k\": \"v\\n\"}, -2.5e3, false]", writer);
+  EXPECT_TRUE(result);
+  EXPECT_EQ(out, "[1,{\"k\":\"v\\n\"},-2500.0,false]");
+}